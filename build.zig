@@ -29,11 +29,53 @@ fn addSokol(b: *bld.Builder, exe: *bld.LibExeObjStep) !void {
     }
 }
 
+const Assets = struct {
+    bake: *bld.Step,
+    atlas_zig: []const u8,
+};
+
+// bakes g_ImageList into data/assets.pack and generates the "atlas" package
+// with the matching UV rects
+fn addAssets(b: *bld.Builder) Assets {
+    const atlas_zig = b.fmt("{s}/atlas.zig", .{b.cache_root});
+
+    const bake = b.addExecutable("bake_assets", "tools/bake_assets.zig");
+    bake.addPackagePath("assets", "src/assets.zig");
+    bake.addPackagePath("pack", "src/pack.zig");
+    const bake_run = bake.run();
+    bake_run.addArgs(&[_][]const u8{ "data/assets.pack", atlas_zig });
+    b.step("assets", "Bake g_ImageList into the asset pack").dependOn(&bake_run.step);
+
+    return .{ .bake = &bake_run.step, .atlas_zig = atlas_zig };
+}
+
+fn useAssets(exe: *bld.LibExeObjStep, assets: Assets) void {
+    exe.step.dependOn(assets.bake);
+    exe.addPackagePath("atlas", assets.atlas_zig);
+}
+
+// benchmark suite on the sokol dummy backend, prints json results
+fn addBench(b: *bld.Builder, assets: Assets) void {
+    const bench = b.addExecutable("bench", "src/bench.zig");
+    bench.setBuildMode(.ReleaseFast);
+    bench.linkLibC();
+    bench.addCSourceFile("src/sokol/sokol_headless.c", &[_][]const u8{});
+    bench.addPackagePath("sokol", "src/sokol/sokol.zig");
+    useAssets(bench, assets);
+    b.step("bench", "Run the benchmark suite").dependOn(&bench.run().step);
+}
+
 pub fn build(b: *bld.Builder) void {
+    const assets = addAssets(b);
     const exe = b.addExecutable("life", "src/life.zig");
     addSokol(b, exe) catch unreachable;
+    useAssets(exe, assets);
     exe.setBuildMode(b.standardReleaseOptions());
     exe.addPackagePath("sokol", "src/sokol/sokol.zig");
     exe.install();
-    b.step("run", "Run life").dependOn(&exe.run().step);
+    const run = exe.run();
+    if (b.args) |args| run.addArgs(args); // zig build run -- --headless --ticks 1000
+    b.step("run", "Run life").dependOn(&run.step);
+
+    addBench(b, assets);
 }
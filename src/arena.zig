@@ -0,0 +1,177 @@
+//------------------------------------------------------------------------------
+//  arena.zig
+//
+//  linear arenas for transient data
+//
+//  an allocation is a pointer bump in a fixed buffer and nothing is freed
+//  until reset() rewinds the whole arena. Allocations that don't fit go to
+//  the backing allocator and are released on reset, the buffer is then
+//  grown to the high water mark so the next round fits again.
+//
+//  not thread safe: one arena is used by one thread at a time
+//------------------------------------------------------------------------------
+const std = @import("std");
+const mem = std.mem;
+const Allocator = mem.Allocator;
+
+pub const Arena = struct {
+    allocator: Allocator = .{
+        .allocFn = alloc,
+        .resizeFn = resize,
+    },
+    backing: *Allocator,
+    buffer: []u8,
+    end: usize = 0,
+    // allocations that didn't fit in buffer, freed on reset
+    overflow: std.ArrayListUnmanaged([]u8) = .{},
+    overflowBytes: usize = 0,
+    // most bytes used between two resets, overflow included
+    highWater: usize = 0,
+
+    pub fn init(backing: *Allocator, capacity: usize) !Arena {
+        return Arena {
+            .backing = backing,
+            .buffer = try backing.alloc(u8, capacity),
+        };
+    }
+
+    pub fn deinit(self: *Arena) void {
+        self.releaseOverflow();
+        self.overflow.deinit(self.backing);
+        self.backing.free(self.buffer);
+        self.* = undefined;
+    }
+
+    pub fn used(self: *const Arena) usize {
+        return self.end + self.overflowBytes;
+    }
+
+    // everything allocated since the last reset is gone after this
+    pub fn reset(self: *Arena) void {
+        self.highWater = std.math.max(self.highWater, self.used());
+        const overflowed = self.overflowBytes > 0;
+        self.releaseOverflow();
+        self.end = 0;
+
+        if (overflowed and self.highWater > self.buffer.len) {
+            const capacity = std.math.ceilPowerOfTwo(usize, self.highWater) catch self.highWater;
+            if (self.backing.alloc(u8, capacity)) |buffer| {
+                self.backing.free(self.buffer);
+                self.buffer = buffer;
+            }
+            else |_| {} // keep overflowing
+        }
+    }
+
+    fn releaseOverflow(self: *Arena) void {
+        for (self.overflow.items) |block| {
+            self.backing.free(block);
+        }
+        self.overflow.clearRetainingCapacity();
+        self.overflowBytes = 0;
+    }
+
+    fn owns(self: *const Arena, buf: []u8) bool {
+        const addr = @ptrToInt(buf.ptr);
+        const start = @ptrToInt(self.buffer.ptr);
+        return addr >= start and addr < start + self.buffer.len;
+    }
+
+    fn alloc(a: *Allocator, len: usize, ptrAlign: u29, lenAlign: u29, retAddr: usize) Allocator.Error![]u8 {
+        const self = @fieldParentPtr(Arena, "allocator", a);
+        const base = @ptrToInt(self.buffer.ptr);
+        const start = mem.alignForward(base + self.end, ptrAlign) - base;
+        if (start + len <= self.buffer.len) {
+            self.end = start + len;
+            return self.buffer[start .. start + len];
+        }
+
+        try self.overflow.ensureCapacity(self.backing, self.overflow.items.len + 1);
+        const block = try self.backing.allocFn(self.backing, len, ptrAlign, lenAlign, retAddr);
+        self.overflow.appendAssumeCapacity(block);
+        self.overflowBytes += block.len;
+        return block;
+    }
+
+    // only the last allocation can grow, and only in place; shrinking the
+    // last one gives the bytes back
+    fn resize(a: *Allocator, buf: []u8, bufAlign: u29, newLen: usize, lenAlign: u29, retAddr: usize) Allocator.Error!usize {
+        const self = @fieldParentPtr(Arena, "allocator", a);
+        if (!self.owns(buf)) {
+            // overflow blocks stay until reset
+            if (newLen <= buf.len) return newLen;
+            return error.OutOfMemory;
+        }
+
+        const start = @ptrToInt(buf.ptr) - @ptrToInt(self.buffer.ptr);
+        const isLast = start + buf.len == self.end;
+        if (newLen <= buf.len) {
+            if (isLast) self.end = start + newLen;
+            return newLen;
+        }
+        if (isLast and start + newLen <= self.buffer.len) {
+            self.end = start + newLen;
+            return newLen;
+        }
+        return error.OutOfMemory;
+    }
+};
+
+// two arenas used on alternate frames, data allocated during frame N stays
+// valid while frame N + 1 is being built
+pub const FrameArenas = struct {
+    arenas: [2]Arena,
+    index: u1 = 0,
+
+    pub fn init(backing: *Allocator, capacity: usize) !FrameArenas {
+        var first = try Arena.init(backing, capacity);
+        errdefer first.deinit();
+        return FrameArenas { .arenas = .{ first, try Arena.init(backing, capacity) } };
+    }
+
+    pub fn deinit(self: *FrameArenas) void {
+        self.arenas[0].deinit();
+        self.arenas[1].deinit();
+    }
+
+    // call once at the start of a frame, frees what frame N - 1 allocated
+    pub fn flip(self: *FrameArenas) *Allocator {
+        self.index +%= 1;
+        self.arenas[self.index].reset();
+        return &self.arenas[self.index].allocator;
+    }
+
+    pub fn current(self: *FrameArenas) *Arena {
+        return &self.arenas[self.index];
+    }
+
+    pub fn highWater(self: *const FrameArenas) usize {
+        return std.math.max(self.arenas[0].highWater, self.arenas[1].highWater);
+    }
+};
+
+test "Arena bumps, grows the last allocation and resets" {
+    var arena = try Arena.init(std.testing.allocator, 256);
+    defer arena.deinit();
+    const allocator = &arena.allocator;
+
+    const a = try allocator.alloc(u8, 10);
+    const b = try allocator.alloc(u32, 4);
+    std.debug.assert(@ptrToInt(b.ptr) % @alignOf(u32) == 0);
+    std.debug.assert(@ptrToInt(b.ptr) > @ptrToInt(a.ptr));
+
+    // b is last, grows in place
+    const c = try allocator.realloc(b, 8);
+    std.debug.assert(c.ptr == b.ptr);
+
+    // doesn't fit, overflows to the backing allocator
+    const big = try allocator.alloc(u8, 1000);
+    std.debug.assert(!arena.owns(big));
+    std.debug.assert(arena.used() >= 1000);
+
+    arena.reset();
+    std.debug.assert(arena.used() == 0);
+    std.debug.assert(arena.highWater >= 1000);
+    // grown to the high water mark, the same round fits now
+    std.debug.assert(arena.buffer.len >= arena.highWater);
+}
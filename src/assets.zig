@@ -0,0 +1,46 @@
+//------------------------------------------------------------------------------
+//  assets.zig
+//
+//  image list shared by the game and the asset bake tools
+//------------------------------------------------------------------------------
+
+pub const ImageEntry = struct {
+    path: []const u8
+};
+
+pub const g_ImageList = [_]ImageEntry {
+    .{ .path = "data/bouffe.png" },
+};
+
+// image "hash"
+// id 0 is "no image" (plain color), g_ImageList[i] is id i+1
+pub const ImageID = struct {
+    u: u32,
+
+    pub fn fromPath(comptime path: []const u8) ImageID
+    {
+        comptime var id: ImageID = .{ .u = 1 };
+
+        for(g_ImageList) |entry| {
+            if(StringEquals(entry.path, path)) {
+                return id;
+            }
+
+            id.u += 1;
+        }
+
+        unreachable;
+    }
+};
+
+fn StringEquals(str1: []const u8, str2: []const u8) bool 
+{
+    if(str1.len != str2.len) return false;
+
+    comptime var i = 0;
+    while(i < str1.len) {
+        if(str1[i] != str2[i]) return false;
+        i += 1;
+    }
+    return true;
+}
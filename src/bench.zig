@@ -0,0 +1,401 @@
+//------------------------------------------------------------------------------
+//  bench.zig
+//
+//  benchmark suite for the hot paths of a tick and a frame
+//
+//  zig build bench
+//
+//  every case runs with fixed seeds and sizes, a few warmup runs first, then
+//  each run is timed on its own. Results go to stdout as json (min, median
+//  and p99 of the run times, in ns) so they can be diffed between commits,
+//  a readable summary goes to stderr. Rendering cases use the sokol dummy
+//  backend (sokol_headless.c): no window and no GPU, only the CPU side of
+//  sokol_gl and sokol_debugtext is measured.
+//------------------------------------------------------------------------------
+const std = @import("std");
+const sokol = @import("sokol");
+const sg = sokol.gfx;
+const sgl = sokol.gl;
+const sdtx = sokol.debugtext;
+const kernels = @import("kernels.zig");
+const grid = @import("grid.zig");
+const sprite = @import("sprite.zig");
+const math = @import("math.zig");
+const assets = @import("assets.zig");
+
+comptime {
+    // prof_begin/prof_end, called by the zones inside sokol_gfx
+    _ = @import("prof.zig");
+}
+
+const warmup_runs = 3;
+const runs = 100;
+
+const agent_count = 1 << 20;
+const food_count = 1 << 16;
+const query_count = 1 << 14;
+const sprite_count = 1 << 17;
+const quad_count = 1 << 14;
+const text_lines = 64;
+const matrix_count = 1 << 16;
+const point_count = 1 << 20;
+
+const world_size = 4096.0;
+const cell_size = 150.0;
+
+const Result = struct {
+    name: []const u8,
+    items: usize, // work items per run
+    min_ns: u64,
+    median_ns: u64,
+    p99_ns: u64,
+};
+
+// times func(context) runs times after the warmup
+fn measure(allocator: *std.mem.Allocator, name: []const u8, items: usize, context: anytype,
+           comptime func: fn (@TypeOf(context)) void) !Result {
+    var i: usize = 0;
+    while (i < warmup_runs): (i += 1) {
+        func(context);
+    }
+
+    const samples = try allocator.alloc(u64, runs);
+    defer allocator.free(samples);
+    for (samples) |*sample| {
+        var timer = try std.time.Timer.start();
+        func(context);
+        sample.* = timer.read();
+    }
+
+    std.sort.sort(u64, samples, {}, comptime std.sort.asc(u64));
+    const result = Result {
+        .name = name,
+        .items = items,
+        .min_ns = samples[0],
+        .median_ns = samples[samples.len / 2],
+        .p99_ns = samples[(samples.len * 99 + 99) / 100 - 1],
+    };
+    std.debug.print("{s:<18} {d:>10} items  min {d:>9.3} ms  median {d:>9.3} ms  p99 {d:>9.3} ms  ({d:.3} ns/item)\n", .{
+        name, items, toMs(result.min_ns), toMs(result.median_ns), toMs(result.p99_ns),
+        @intToFloat(f64, result.median_ns) / @intToFloat(f64, items),
+    });
+    return result;
+}
+
+fn toMs(ns: u64) f64 {
+    return @intToFloat(f64, ns) / std.time.ns_per_ms;
+}
+
+fn randomColumn(allocator: *std.mem.Allocator, random: *std.rand.Random, n: usize, range: f32) ![]f32 {
+    const column = try allocator.alloc(f32, n);
+    for (column) |*v| {
+        v.* = (random.float(f32) - 0.5) * range;
+    }
+    return column;
+}
+
+//------------------------------------------------------------------------------
+//  agent update
+//------------------------------------------------------------------------------
+const Agents = struct {
+    posX: []f32,
+    posY: []f32,
+    prevX: []f32,
+    prevY: []f32,
+    velX: []f32,
+    velY: []f32,
+    energy: []f32,
+    visible: []u32,
+
+    fn init(allocator: *std.mem.Allocator) !Agents {
+        var prng = std.rand.DefaultPrng.init(42);
+        var agents: Agents = undefined;
+        inline for (std.meta.fields(Agents)) |field| {
+            if (field.field_type == []f32) {
+                @field(agents, field.name) = try randomColumn(allocator, &prng.random, agent_count, world_size);
+            }
+        }
+        agents.visible = try allocator.alloc(u32, agent_count);
+        return agents;
+    }
+
+    fn moveColumns(self: Agents) kernels.MoveColumns {
+        return .{
+            .posX = self.posX, .posY = self.posY,
+            .prevX = self.prevX, .prevY = self.prevY,
+            .velX = self.velX, .velY = self.velY,
+        };
+    }
+
+    fn cullColumns(self: Agents) kernels.CullColumns {
+        return .{
+            .posX = self.posX, .posY = self.posY,
+            .prevX = self.prevX, .prevY = self.prevY,
+        };
+    }
+};
+
+const move_params = kernels.MoveParams { .dt = 1.0 / 60.0, .worldHalf = world_size / 2.0 };
+// about a screen at default zoom
+const view = kernels.Rect { .minX = -800.0, .minY = -450.0, .maxX = 800.0, .maxY = 450.0 };
+
+fn moveScalar(a: *Agents) void {
+    kernels.moveScalar(a.moveColumns(), move_params);
+}
+
+fn moveSimd(a: *Agents) void {
+    kernels.moveSimd(kernels.lanes, a.moveColumns(), move_params);
+}
+
+fn decayScalar(a: *Agents) void {
+    kernels.decayScalar(a.energy, 0.001);
+}
+
+fn decaySimd(a: *Agents) void {
+    kernels.decaySimd(kernels.lanes, a.energy, 0.001);
+}
+
+fn cullScalar(a: *Agents) void {
+    std.mem.doNotOptimizeAway(kernels.cullScalar(a.cullColumns(), 0.5, view, a.visible));
+}
+
+fn cullSimd(a: *Agents) void {
+    std.mem.doNotOptimizeAway(kernels.cullSimd(kernels.lanes, a.cullColumns(), 0.5, view, a.visible));
+}
+
+//------------------------------------------------------------------------------
+//  spatial grid
+//------------------------------------------------------------------------------
+const GridBench = struct {
+    grid: grid.Grid,
+    scratch: *std.mem.Allocator,
+    xs: []f32,
+    ys: []f32,
+    queryX: []f32,
+    queryY: []f32,
+
+    fn init(allocator: *std.mem.Allocator) !GridBench {
+        var prng = std.rand.DefaultPrng.init(7);
+        return GridBench {
+            .grid = grid.Grid.init(allocator, cell_size),
+            .scratch = allocator,
+            .xs = try randomColumn(allocator, &prng.random, food_count, world_size),
+            .ys = try randomColumn(allocator, &prng.random, food_count, world_size),
+            .queryX = try randomColumn(allocator, &prng.random, query_count, world_size),
+            .queryY = try randomColumn(allocator, &prng.random, query_count, world_size),
+        };
+    }
+};
+
+fn gridBuild(g: *GridBench) void {
+    g.grid.build(g.xs, g.ys, g.scratch) catch unreachable;
+}
+
+fn gridNearest(g: *GridBench) void {
+    for (g.queryX) |x, i| {
+        std.mem.doNotOptimizeAway(g.grid.nearest(x, g.queryY[i], cell_size, grid.AcceptAll{}));
+    }
+}
+
+fn gridRect(g: *GridBench) void {
+    const Count = struct {
+        n: usize = 0,
+        fn visit(c: *@This(), index: u32) void {
+            c.n += 1;
+        }
+    };
+    var count = Count{};
+    g.grid.forEachInRect(view.minX, view.minY, view.maxX, view.maxY, &count);
+    std.mem.doNotOptimizeAway(count.n);
+}
+
+//------------------------------------------------------------------------------
+//  sprite batch packing
+//------------------------------------------------------------------------------
+const SpriteBench = struct {
+    queue: []sprite.RenderCommandSprite,
+    instances: []sprite.SpriteInstance,
+
+    fn init(allocator: *std.mem.Allocator) !SpriteBench {
+        var prng = std.rand.DefaultPrng.init(3);
+        const random = &prng.random;
+        const queue = try allocator.alloc(sprite.RenderCommandSprite, sprite_count);
+        for (queue) |*cmd, i| {
+            cmd.* = .{
+                .pos = math.Vec2.new((random.float(f32) - 0.5) * world_size, (random.float(f32) - 0.5) * world_size),
+                .scale = math.Vec2.new(20, 20),
+                .rot = random.float(f32) * std.math.tau,
+                // plain color agents mixed with textured food, like a frame
+                .imgID = if (i % 8 == 0) comptime assets.ImageID.fromPath("data/bouffe.png") else .{ .u = 0 },
+            };
+        }
+        return SpriteBench {
+            .queue = queue,
+            .instances = try allocator.alloc(sprite.SpriteInstance, sprite_count),
+        };
+    }
+};
+
+fn spritePack(s: *SpriteBench) void {
+    sprite.packInstances(s.queue, s.instances);
+}
+
+//------------------------------------------------------------------------------
+//  Mat4 products and batch transforms
+//------------------------------------------------------------------------------
+const MathBench = struct {
+    matrices: []math.Mat4,
+    products: []math.Mat4,
+    points: []math.Vec2,
+    transformed: []math.Vec2,
+    points3: []math.Vec3,
+    transformed3: []math.Vec3,
+    view: math.Mat4,
+
+    fn init(allocator: *std.mem.Allocator) !MathBench {
+        var prng = std.rand.DefaultPrng.init(11);
+        const random = &prng.random;
+        const matrices = try allocator.alloc(math.Mat4, matrix_count);
+        for (matrices) |*m| {
+            m.* = math.Mat4.mulScalar(
+                math.Mat4.translate(math.Vec3.new(random.float(f32), random.float(f32), random.float(f32))),
+                math.Mat4.rotate(random.float(f32) * 360.0, math.Vec3.new(0.0, 0.0, 1.0)));
+        }
+        const points = try allocator.alloc(math.Vec2, point_count);
+        const points3 = try allocator.alloc(math.Vec3, point_count);
+        for (points) |*p, i| {
+            p.* = math.Vec2.new((random.float(f32) - 0.5) * world_size, (random.float(f32) - 0.5) * world_size);
+            points3[i] = math.Vec3.new(p.x, p.y, random.float(f32));
+        }
+        return MathBench {
+            .matrices = matrices,
+            .products = try allocator.alloc(math.Mat4, matrix_count),
+            .points = points,
+            .transformed = try allocator.alloc(math.Vec2, point_count),
+            .points3 = points3,
+            .transformed3 = try allocator.alloc(math.Vec3, point_count),
+            .view = math.Mat4.ortho(view.minX, view.maxX, view.maxY, view.minY, -10.0, 10.0),
+        };
+    }
+};
+
+fn mat4MulScalar(b: *MathBench) void {
+    for (b.matrices) |m, i| {
+        b.products[i] = math.Mat4.mulScalar(b.view, m);
+    }
+}
+
+fn mat4MulSimd(b: *MathBench) void {
+    for (b.matrices) |m, i| {
+        b.products[i] = math.Mat4.mul(b.view, m);
+    }
+}
+
+fn transform2Scalar(b: *MathBench) void {
+    math.Mat4.transformPoints2Scalar(b.view, b.points, b.transformed);
+}
+
+fn transform2Simd(b: *MathBench) void {
+    math.Mat4.transformPoints2(b.view, b.points, b.transformed);
+}
+
+fn transform3Scalar(b: *MathBench) void {
+    math.Mat4.transformPoints3Scalar(b.view, b.points3, b.transformed3);
+}
+
+fn transform3Simd(b: *MathBench) void {
+    math.Mat4.transformPoints3(b.view, b.points3, b.transformed3);
+}
+
+//------------------------------------------------------------------------------
+//  sokol_gl and sokol_debugtext, dummy backend
+//------------------------------------------------------------------------------
+const pass_action = sg.PassAction{};
+
+fn sglQuads(context: void) void {
+    sgl.defaults();
+    sgl.beginQuads();
+    var i: usize = 0;
+    while (i < quad_count): (i += 1) {
+        const x = @intToFloat(f32, i % 128) / 64.0 - 1.0;
+        const y = @intToFloat(f32, i / 128) / 64.0 - 1.0;
+        const s = 1.0 / 128.0;
+        sgl.v2fT2fC1i(x, y, 0, 0, 0xFFFFFFFF);
+        sgl.v2fT2fC1i(x + s, y, 1, 0, 0xFFFFFFFF);
+        sgl.v2fT2fC1i(x + s, y + s, 1, 1, 0xFFFFFFFF);
+        sgl.v2fT2fC1i(x, y + s, 0, 1, 0xFFFFFFFF);
+    }
+    sgl.end();
+    sg.beginDefaultPass(pass_action, 1280, 720);
+    sgl.draw();
+    sg.endPass();
+    sg.commit();
+}
+
+fn sdtxLayout(context: void) void {
+    sdtx.canvas(640, 360);
+    sdtx.origin(1, 1);
+    var line: usize = 0;
+    while (line < text_lines): (line += 1) {
+        sdtx.color3b(0xFF, 0xC0, 0x40);
+        sdtx.print("zone {d:>3}  calls {d:>5}  total {d:>8.3} ms  max {d:>8.3} ms\n", .{
+            line, line * 7, @intToFloat(f32, line) * 0.125, @intToFloat(f32, line) * 0.5,
+        });
+    }
+    sg.beginDefaultPass(pass_action, 1280, 720);
+    sdtx.draw();
+    sg.endPass();
+    sg.commit();
+}
+
+//------------------------------------------------------------------------------
+pub fn main() !void {
+    // run data lives until exit
+    const allocator = std.heap.page_allocator;
+    var results = std.ArrayList(Result).init(allocator);
+
+    var agents = try Agents.init(allocator);
+    try results.append(try measure(allocator, "move_scalar", agent_count, &agents, moveScalar));
+    try results.append(try measure(allocator, "move_simd", agent_count, &agents, moveSimd));
+    try results.append(try measure(allocator, "decay_scalar", agent_count, &agents, decayScalar));
+    try results.append(try measure(allocator, "decay_simd", agent_count, &agents, decaySimd));
+    try results.append(try measure(allocator, "cull_scalar", agent_count, &agents, cullScalar));
+    try results.append(try measure(allocator, "cull_simd", agent_count, &agents, cullSimd));
+
+    var gridBench = try GridBench.init(allocator);
+    try results.append(try measure(allocator, "grid_build", food_count, &gridBench, gridBuild));
+    try results.append(try measure(allocator, "grid_nearest", query_count, &gridBench, gridNearest));
+    try results.append(try measure(allocator, "grid_rect", food_count, &gridBench, gridRect));
+
+    var spriteBench = try SpriteBench.init(allocator);
+    try results.append(try measure(allocator, "sprite_pack", sprite_count, &spriteBench, spritePack));
+
+    var mathBench = try MathBench.init(allocator);
+    try results.append(try measure(allocator, "mat4_mul_scalar", matrix_count, &mathBench, mat4MulScalar));
+    try results.append(try measure(allocator, "mat4_mul_simd", matrix_count, &mathBench, mat4MulSimd));
+    try results.append(try measure(allocator, "transform2_scalar", point_count, &mathBench, transform2Scalar));
+    try results.append(try measure(allocator, "transform2_simd", point_count, &mathBench, transform2Simd));
+    try results.append(try measure(allocator, "transform3_scalar", point_count, &mathBench, transform3Scalar));
+    try results.append(try measure(allocator, "transform3_simd", point_count, &mathBench, transform3Simd));
+
+    sokol.time.setup(); // the sokol_gfx zones are stamped with it
+    sg.setup(.{});
+    defer sg.shutdown();
+    sgl.setup(.{ .max_vertices = quad_count * 6, .max_commands = 16 });
+    defer sgl.shutdown();
+    var sdtxDesc: sdtx.Desc = .{};
+    sdtxDesc.fonts[0] = sdtx.fontKc853();
+    sdtxDesc.context.char_buf_size = text_lines * 80;
+    sdtx.setup(sdtxDesc);
+    defer sdtx.shutdown();
+    try results.append(try measure(allocator, "sgl_quads", quad_count, {}, sglQuads));
+    try results.append(try measure(allocator, "sdtx_layout", text_lines, {}, sdtxLayout));
+
+    const out = std.io.getStdOut().writer();
+    try std.json.stringify(.{
+        .warmup_runs = warmup_runs,
+        .runs = runs,
+        .results = results.items,
+    }, .{ .whitespace = .{} }, out);
+    try out.writeByte('\n');
+}
@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+//  chunks.zig
+//
+//  dirty tracking for world content that is baked per chunk
+//
+//  the world is cut into fixed size square chunks. Code changing something
+//  inside a chunk sets its dirty bit, publish() then stamps every dirty
+//  chunk with the sequence number of that publication. A consumer caching
+//  baked chunks reports the last publication it saw and gets every chunk
+//  stamped after it again, so skipping publications never loses a change.
+//------------------------------------------------------------------------------
+const std = @import("std");
+const mem = std.mem;
+const Rect = @import("kernels.zig").Rect;
+
+pub const ChunkMap = struct {
+    allocator: *mem.Allocator,
+    worldHalf: f32,
+    chunkSize: f32,
+    side: u32, // chunks per row and per column
+    dirty: []u64, // one bit per chunk
+    changedAt: []u64, // last publication carrying a change of the chunk
+    seq: u64 = 0,
+
+    // the world spans [-worldSize / 2, worldSize / 2] on both axes, every
+    // chunk starts out dirty
+    pub fn init(allocator: *mem.Allocator, worldSize: f32, chunkSize: f32) !ChunkMap {
+        const side = @floatToInt(u32, std.math.ceil(worldSize / chunkSize));
+        const chunks = side * side;
+        const dirty = try allocator.alloc(u64, (chunks + 63) / 64);
+        errdefer allocator.free(dirty);
+        const changedAt = try allocator.alloc(u64, chunks);
+        mem.set(u64, changedAt, 0);
+
+        var map = ChunkMap {
+            .allocator = allocator,
+            .worldHalf = worldSize / 2.0,
+            .chunkSize = chunkSize,
+            .side = side,
+            .dirty = dirty,
+            .changedAt = changedAt,
+        };
+        map.markAll();
+        return map;
+    }
+
+    pub fn deinit(self: *ChunkMap) void {
+        self.allocator.free(self.dirty);
+        self.allocator.free(self.changedAt);
+        self.* = undefined;
+    }
+
+    pub fn count(self: ChunkMap) u32 {
+        return @intCast(u32, self.changedAt.len);
+    }
+
+    // positions outside the world land in the border chunks
+    fn coord(self: ChunkMap, v: f32) u32 {
+        const c = @floatToInt(i32, std.math.floor((v + self.worldHalf) / self.chunkSize));
+        return @intCast(u32, std.math.clamp(c, 0, @intCast(i32, self.side) - 1));
+    }
+
+    pub fn chunkOf(self: ChunkMap, x: f32, y: f32) u32 {
+        return self.coord(y) * self.side + self.coord(x);
+    }
+
+    pub fn rect(self: ChunkMap, chunk: u32) Rect {
+        const minX = @intToFloat(f32, chunk % self.side) * self.chunkSize - self.worldHalf;
+        const minY = @intToFloat(f32, chunk / self.side) * self.chunkSize - self.worldHalf;
+        return .{ .minX = minX, .minY = minY, .maxX = minX + self.chunkSize, .maxY = minY + self.chunkSize };
+    }
+
+    pub fn markDirty(self: *ChunkMap, x: f32, y: f32) void {
+        const chunk = self.chunkOf(x, y);
+        self.dirty[chunk / 64] |= @as(u64, 1) << @intCast(u6, chunk % 64);
+    }
+
+    pub fn markAll(self: *ChunkMap) void {
+        mem.set(u64, self.dirty, std.math.maxInt(u64));
+    }
+
+    // stamps and clears the dirty chunks, returns the new sequence number
+    pub fn publish(self: *ChunkMap) u64 {
+        self.seq += 1;
+        for (self.dirty) |*word, w| {
+            var bits = word.*;
+            while (bits != 0) {
+                const chunk = w * 64 + @ctz(u64, bits);
+                bits &= bits - 1;
+                if (chunk < self.changedAt.len) self.changedAt[chunk] = self.seq;
+            }
+            word.* = 0;
+        }
+        return self.seq;
+    }
+
+    // whether a consumer that last saw publication seen has to rebake chunk
+    pub fn changedSince(self: ChunkMap, chunk: u32, seen: u64) bool {
+        return self.changedAt[chunk] > seen;
+    }
+};
+
+test "ChunkMap resends changes a consumer skipped" {
+    var map = try ChunkMap.init(std.testing.allocator, 100.0, 10.0);
+    defer map.deinit();
+    std.debug.assert(map.count() == 100);
+    std.debug.assert(map.chunkOf(-50.0, -50.0) == 0);
+    std.debug.assert(map.chunkOf(49.0, -50.0) == 9);
+    std.debug.assert(map.chunkOf(500.0, 500.0) == 99);
+    std.debug.assert(map.rect(11).minX == -40.0 and map.rect(11).maxY == -30.0);
+
+    // everything starts dirty
+    const first = map.publish();
+    std.debug.assert(map.changedSince(0, 0) and map.changedSince(99, 0));
+    std.debug.assert(!map.changedSince(99, first));
+
+    map.markDirty(-45.0, -45.0);
+    const second = map.publish();
+    map.markDirty(45.0, 45.0);
+    _ = map.publish();
+
+    // saw the first publication only: both changes come again
+    std.debug.assert(map.changedSince(0, first) and map.changedSince(99, first));
+    // saw the second one: only the later change
+    std.debug.assert(!map.changedSince(0, second) and map.changedSince(99, second));
+    std.debug.assert(!map.changedSince(50, first));
+}
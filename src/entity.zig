@@ -0,0 +1,283 @@
+//------------------------------------------------------------------------------
+//  entity.zig
+//
+//  structure-of-arrays entity storage
+//
+//  every field of T lives in its own tightly packed column, so update loops
+//  only stream the fields they touch. Entities are referenced through
+//  handles with a generation counter (same idea as sokol's _sg_pool_t), which
+//  stay valid while the dense columns are compacted with swap-remove.
+//------------------------------------------------------------------------------
+const std = @import("std");
+const mem = std.mem;
+const assert = std.debug.assert;
+
+// columns are cache line aligned so SIMD loops start on a clean boundary
+pub const column_align = 64;
+
+pub const Handle = struct {
+    index: u32 = 0,
+    gen: u32 = 0, // 0 is never handed out: Handle{} is the invalid handle
+
+    pub fn isNull(h: Handle) bool {
+        return h.gen == 0;
+    }
+};
+
+pub fn Store(comptime T: type) type {
+    return struct {
+        const Self = @This();
+        pub const Field = std.meta.FieldEnum(T);
+        const fields = std.meta.fields(T);
+        pub const column_count = fields.len;
+        pub const column_sizes = blk: {
+            var sizes: [fields.len]usize = undefined;
+            for (fields) |field, i| {
+                sizes[i] = @sizeOf(field.field_type);
+            }
+            break :blk sizes;
+        };
+
+        pub fn FieldType(comptime field: Field) type {
+            return std.meta.fieldInfo(T, field).field_type;
+        }
+
+        allocator: *mem.Allocator,
+        columns: [fields.len][*]align(column_align) u8 = undefined,
+        len: u32 = 0,
+        capacity: u32 = 0,
+        // false while the columns point into memory we don't own (a mapped
+        // snapshot), the first growth copies them out
+        ownsColumns: bool = true,
+
+        // handle slots, one per capacity entry
+        slotGen: std.ArrayListUnmanaged(u32) = .{},
+        slotDense: std.ArrayListUnmanaged(u32) = .{}, // slot -> dense index
+        denseSlot: std.ArrayListUnmanaged(u32) = .{}, // dense index -> slot
+        freeSlots: std.ArrayListUnmanaged(u32) = .{}, // stack of unused slots
+
+        pub fn init(allocator: *mem.Allocator) Self {
+            return .{ .allocator = allocator };
+        }
+
+        // uses columns[i] (len entries each) in place, handles are reissued
+        // with slot i for entity i
+        pub fn initBorrowed(allocator: *mem.Allocator, columns: [fields.len][]align(column_align) u8, len: u32) !Self {
+            var self = Self { .allocator = allocator, .len = len, .capacity = len, .ownsColumns = false };
+            for (columns) |column, i| {
+                assert(column.len == len * column_sizes[i]);
+                self.columns[i] = column.ptr;
+            }
+            errdefer self.deinit();
+
+            try self.slotGen.resize(allocator, len);
+            try self.slotDense.resize(allocator, len);
+            try self.denseSlot.resize(allocator, len);
+            try self.freeSlots.ensureCapacity(allocator, len);
+            var i: u32 = 0;
+            while (i < len): (i += 1) {
+                self.slotGen.items[i] = 1;
+                self.slotDense.items[i] = i;
+                self.denseSlot.items[i] = i;
+            }
+            return self;
+        }
+
+        pub fn deinit(self: *Self) void {
+            if (self.capacity > 0 and self.ownsColumns) {
+                inline for (fields) |field, i| {
+                    self.allocator.free(self.columns[i][0 .. self.capacity * @sizeOf(field.field_type)]);
+                }
+            }
+            self.slotGen.deinit(self.allocator);
+            self.slotDense.deinit(self.allocator);
+            self.denseSlot.deinit(self.allocator);
+            self.freeSlots.deinit(self.allocator);
+            self.* = undefined;
+        }
+
+        pub fn ensureCapacity(self: *Self, wanted: u32) !void {
+            if (wanted <= self.capacity) return;
+            var capacity = std.math.max(self.capacity, 64);
+            while (capacity < wanted) {
+                capacity *= 2;
+            }
+
+            inline for (fields) |field, i| {
+                const size = @sizeOf(field.field_type);
+                const column = try self.allocator.allocAdvanced(u8, column_align, capacity * size, .exact);
+                if (self.capacity > 0) {
+                    mem.copy(u8, column, self.columns[i][0 .. self.len * size]);
+                    if (self.ownsColumns) {
+                        self.allocator.free(self.columns[i][0 .. self.capacity * size]);
+                    }
+                }
+                self.columns[i] = column.ptr;
+            }
+            self.ownsColumns = true;
+
+            try self.slotGen.resize(self.allocator, capacity);
+            try self.slotDense.resize(self.allocator, capacity);
+            try self.denseSlot.resize(self.allocator, capacity);
+            try self.freeSlots.ensureCapacity(self.allocator, capacity);
+
+            // every slot is in use when we grow, push the new ones so the
+            // lowest comes out first
+            var slot = capacity;
+            while (slot > self.capacity) {
+                slot -= 1;
+                self.slotGen.items[slot] = 1;
+                self.freeSlots.appendAssumeCapacity(slot);
+            }
+            self.capacity = capacity;
+        }
+
+        pub fn create(self: *Self, value: T) !Handle {
+            try self.ensureCapacity(self.len + 1);
+
+            const slot = self.freeSlots.pop();
+            const dense = self.len;
+            self.len += 1;
+            self.slotDense.items[slot] = dense;
+            self.denseSlot.items[dense] = slot;
+            self.set(dense, value);
+            return Handle { .index = slot, .gen = self.slotGen.items[slot] };
+        }
+
+        pub fn isAlive(self: Self, h: Handle) bool {
+            return !h.isNull() and h.index < self.capacity and self.slotGen.items[h.index] == h.gen;
+        }
+
+        // dense index of a live entity, only valid until the next destroy
+        pub fn indexOf(self: Self, h: Handle) ?u32 {
+            if (!self.isAlive(h)) return null;
+            return self.slotDense.items[h.index];
+        }
+
+        pub fn handleAt(self: Self, dense: u32) Handle {
+            const slot = self.denseSlot.items[dense];
+            return Handle { .index = slot, .gen = self.slotGen.items[slot] };
+        }
+
+        // swap-remove: the last entity moves into the hole, columns stay packed
+        pub fn destroy(self: *Self, h: Handle) bool {
+            const dense = self.indexOf(h) orelse return false;
+            self.removeAt(dense);
+            return true;
+        }
+
+        pub fn removeAt(self: *Self, dense: u32) void {
+            assert(dense < self.len);
+            const slot = self.denseSlot.items[dense];
+            const last = self.len - 1;
+            if (dense != last) {
+                inline for (fields) |field, i| {
+                    const column = self.items(@intToEnum(Field, i));
+                    column[dense] = column[last];
+                }
+                const moved = self.denseSlot.items[last];
+                self.denseSlot.items[dense] = moved;
+                self.slotDense.items[moved] = dense;
+            }
+            self.len = last;
+
+            // invalidate outstanding handles, skip 0 on wrap around
+            const gen = &self.slotGen.items[slot];
+            gen.* +%= 1;
+            if (gen.* == 0) gen.* = 1;
+            self.freeSlots.appendAssumeCapacity(slot);
+        }
+
+        pub fn clear(self: *Self) void {
+            while (self.len > 0) {
+                self.removeAt(self.len - 1);
+            }
+        }
+
+        // raw bytes of a column, len entries
+        pub fn columnBytes(self: Self, index: usize) []align(column_align) u8 {
+            return self.columns[index][0 .. self.len * column_sizes[index]];
+        }
+
+        pub fn items(self: Self, comptime field: Field) []FieldType(field) {
+            const F = FieldType(field);
+            const ptr = @ptrCast([*]F, @alignCast(@alignOf(F), self.columns[@enumToInt(field)]));
+            return ptr[0..self.len];
+        }
+
+        pub fn set(self: *Self, dense: u32, value: T) void {
+            inline for (fields) |field, i| {
+                self.items(@intToEnum(Field, i))[dense] = @field(value, field.name);
+            }
+        }
+
+        pub fn get(self: Self, dense: u32) T {
+            var value: T = undefined;
+            inline for (fields) |field, i| {
+                @field(value, field.name) = self.items(@intToEnum(Field, i))[dense];
+            }
+            return value;
+        }
+    };
+}
+
+const TestEntity = struct {
+    x: f32,
+    id: u32,
+};
+
+test "Store.destroy invalidates handle" {
+    var store = Store(TestEntity).init(std.testing.allocator);
+    defer store.deinit();
+
+    const a = try store.create(.{ .x = 1.0, .id = 1 });
+    const b = try store.create(.{ .x = 2.0, .id = 2 });
+    assert(store.destroy(a));
+    assert(!store.isAlive(a));
+    assert(!store.destroy(a));
+    assert(store.isAlive(b));
+
+    // the slot is reused with a new generation
+    const c = try store.create(.{ .x = 3.0, .id = 3 });
+    assert(c.index == a.index and c.gen != a.gen);
+    assert(!store.isAlive(a));
+}
+
+test "Store.removeAt keeps columns packed" {
+    var store = Store(TestEntity).init(std.testing.allocator);
+    defer store.deinit();
+
+    var handles: [100]Handle = undefined;
+    for (handles) |*h, i| {
+        h.* = try store.create(.{ .x = @intToFloat(f32, i), .id = @intCast(u32, i) });
+    }
+    var i: usize = 0;
+    while (i < handles.len): (i += 2) {
+        assert(store.destroy(handles[i]));
+    }
+
+    assert(store.len == 50);
+    for (handles) |h, j| {
+        if (j % 2 == 0) continue;
+        const dense = store.indexOf(h).?;
+        assert(store.items(.id)[dense] == j);
+        assert(store.get(dense).x == @intToFloat(f32, j));
+    }
+}
+
+test "Store.initBorrowed copies out on growth" {
+    var xs align(column_align) = [_]f32 { 1.0, 2.0, 3.0 };
+    var ids align(column_align) = [_]u32 { 1, 2, 3 };
+    var store = try Store(TestEntity).initBorrowed(std.testing.allocator, .{
+        mem.sliceAsBytes(xs[0..]), mem.sliceAsBytes(ids[0..]),
+    }, 3);
+    defer store.deinit();
+
+    assert(store.get(1).x == 2.0);
+    assert(store.isAlive(store.handleAt(2)));
+    _ = try store.create(.{ .x = 4.0, .id = 4 });
+    assert(store.ownsColumns);
+    store.items(.x)[0] = 10.0;
+    assert(xs[0] == 1.0);
+    assert(store.get(3).id == 4);
+}
@@ -0,0 +1,335 @@
+//------------------------------------------------------------------------------
+//  grid.zig
+//
+//  uniform spatial hash grid for radius, rect and nearest neighbour queries
+//
+//  the grid is rebuilt from scratch every tick with a counting sort: count
+//  items per bucket, prefix sum, scatter. Items of a bucket end up contiguous
+//  together with a copy of their position, so a query only touches a few
+//  small runs of memory. Cells are hashed into a power of two bucket table,
+//  which keeps memory proportional to the item count for any world size.
+//------------------------------------------------------------------------------
+const std = @import("std");
+const mem = std.mem;
+const assert = std.debug.assert;
+
+pub const Grid = struct {
+    allocator: *mem.Allocator,
+    cellSize: f32,
+    invCellSize: f32,
+
+    bucketMask: u32 = 0,
+    bucketStart: std.ArrayListUnmanaged(u32) = .{}, // bucket count + 1 entries
+
+    // items sorted by bucket
+    itemX: std.ArrayListUnmanaged(f32) = .{},
+    itemY: std.ArrayListUnmanaged(f32) = .{},
+    itemCell: std.ArrayListUnmanaged(u64) = .{}, // packed cell coords, rejects hash collisions
+    itemIndex: std.ArrayListUnmanaged(u32) = .{}, // index in the arrays given to build()
+
+    pub fn init(allocator: *mem.Allocator, cellSize: f32) Grid {
+        var grid = Grid {
+            .allocator = allocator,
+            .cellSize = undefined,
+            .invCellSize = undefined,
+        };
+        grid.setCellSize(cellSize);
+        return grid;
+    }
+
+    pub fn deinit(self: *Grid) void {
+        self.bucketStart.deinit(self.allocator);
+        self.itemX.deinit(self.allocator);
+        self.itemY.deinit(self.allocator);
+        self.itemCell.deinit(self.allocator);
+        self.itemIndex.deinit(self.allocator);
+        self.* = undefined;
+    }
+
+    // takes effect on the next build(), best around the typical query radius
+    pub fn setCellSize(self: *Grid, cellSize: f32) void {
+        assert(cellSize > 0.0);
+        self.cellSize = cellSize;
+        self.invCellSize = 1.0 / cellSize;
+    }
+
+    fn cellCoord(self: Grid, v: f32) i32 {
+        return @floatToInt(i32, std.math.floor(v * self.invCellSize));
+    }
+
+    fn cellKey(cx: i32, cy: i32) u64 {
+        return (@as(u64, @bitCast(u32, cx)) << 32) | @bitCast(u32, cy);
+    }
+
+    fn bucketOf(self: Grid, cx: i32, cy: i32) u32 {
+        const h = (@bitCast(u32, cx) *% 73856093) ^ (@bitCast(u32, cy) *% 19349663);
+        return h & self.bucketMask;
+    }
+
+    pub fn count(self: Grid) usize {
+        return self.itemIndex.items.len;
+    }
+
+    // the build temporaries come from scratch, meant to be a per-tick arena
+    pub fn build(self: *Grid, xs: []const f32, ys: []const f32, scratch: *mem.Allocator) !void {
+        assert(xs.len == ys.len);
+        const n = xs.len;
+
+        // about two buckets per item keeps collisions rare
+        var buckets: usize = 64;
+        while (buckets < n * 2) {
+            buckets *= 2;
+        }
+        self.bucketMask = @intCast(u32, buckets - 1);
+
+        try self.bucketStart.resize(self.allocator, buckets + 1);
+        const cursor = try scratch.alloc(u32, buckets);
+        defer scratch.free(cursor);
+        const inputBucket = try scratch.alloc(u32, n);
+        defer scratch.free(inputBucket);
+        try self.itemX.resize(self.allocator, n);
+        try self.itemY.resize(self.allocator, n);
+        try self.itemCell.resize(self.allocator, n);
+        try self.itemIndex.resize(self.allocator, n);
+
+        // count
+        const start = self.bucketStart.items;
+        mem.set(u32, start, 0);
+        for (xs) |x, i| {
+            const b = self.bucketOf(self.cellCoord(x), self.cellCoord(ys[i]));
+            inputBucket[i] = b;
+            start[b + 1] += 1;
+        }
+
+        // prefix sum
+        var b: usize = 1;
+        while (b < start.len): (b += 1) {
+            start[b] += start[b - 1];
+        }
+
+        // scatter
+        mem.copy(u32, cursor, start[0..buckets]);
+        for (inputBucket) |bucket, i| {
+            const dst = cursor[bucket];
+            cursor[bucket] += 1;
+            self.itemIndex.items[dst] = @intCast(u32, i);
+            self.itemX.items[dst] = xs[i];
+            self.itemY.items[dst] = ys[i];
+            self.itemCell.items[dst] = cellKey(self.cellCoord(xs[i]), self.cellCoord(ys[i]));
+        }
+    }
+
+    // calls visitor.visit(index, distSq) for every item within radius of (x, y)
+    pub fn forEachInRadius(self: Grid, x: f32, y: f32, radius: f32, visitor: anytype) void {
+        if (self.count() == 0) return;
+        const r2 = radius * radius;
+        const cx0 = self.cellCoord(x - radius);
+        const cx1 = self.cellCoord(x + radius);
+        const cy0 = self.cellCoord(y - radius);
+        const cy1 = self.cellCoord(y + radius);
+
+        var cy = cy0;
+        while (cy <= cy1): (cy += 1) {
+            var cx = cx0;
+            while (cx <= cx1): (cx += 1) {
+                self.visitCell(cx, cy, x, y, r2, visitor);
+            }
+        }
+    }
+
+    fn visitCell(self: Grid, cx: i32, cy: i32, x: f32, y: f32, r2: f32, visitor: anytype) void {
+        const key = cellKey(cx, cy);
+        const b = self.bucketOf(cx, cy);
+        var i = self.bucketStart.items[b];
+        const end = self.bucketStart.items[b + 1];
+        while (i < end): (i += 1) {
+            if (self.itemCell.items[i] != key) continue;
+            const dx = self.itemX.items[i] - x;
+            const dy = self.itemY.items[i] - y;
+            const d2 = dx * dx + dy * dy;
+            if (d2 <= r2) {
+                visitor.visit(self.itemIndex.items[i], d2);
+            }
+        }
+    }
+
+    // calls visitor.visit(index) for every item inside the rect, used for
+    // view culling
+    pub fn forEachInRect(self: Grid, minX: f32, minY: f32, maxX: f32, maxY: f32, visitor: anytype) void {
+        if (self.count() == 0 or minX > maxX or minY > maxY) return;
+        const cx0 = self.cellCoord(minX);
+        const cx1 = self.cellCoord(maxX);
+        const cy0 = self.cellCoord(minY);
+        const cy1 = self.cellCoord(maxY);
+
+        // zoomed out past the item count, a straight scan is cheaper
+        const cells = @as(u64, @intCast(u32, cx1 - cx0 + 1)) * @intCast(u32, cy1 - cy0 + 1);
+        if (cells >= self.count()) {
+            for (self.itemX.items) |x, i| {
+                const y = self.itemY.items[i];
+                if (x >= minX and x <= maxX and y >= minY and y <= maxY) {
+                    visitor.visit(self.itemIndex.items[i]);
+                }
+            }
+            return;
+        }
+
+        var cy = cy0;
+        while (cy <= cy1): (cy += 1) {
+            var cx = cx0;
+            while (cx <= cx1): (cx += 1) {
+                const key = cellKey(cx, cy);
+                const b = self.bucketOf(cx, cy);
+                var i = self.bucketStart.items[b];
+                const end = self.bucketStart.items[b + 1];
+                while (i < end): (i += 1) {
+                    if (self.itemCell.items[i] != key) continue;
+                    const x = self.itemX.items[i];
+                    const y = self.itemY.items[i];
+                    if (x >= minX and x <= maxX and y >= minY and y <= maxY) {
+                        visitor.visit(self.itemIndex.items[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    // appends the index of every item within radius of (x, y)
+    pub fn queryRadius(self: Grid, x: f32, y: f32, radius: f32, out: *std.ArrayList(u32)) !void {
+        const Collect = struct {
+            out: *std.ArrayList(u32),
+            err: ?mem.Allocator.Error = null,
+
+            fn visit(c: *@This(), index: u32, d2: f32) void {
+                c.out.append(index) catch |e| {
+                    c.err = e;
+                };
+            }
+        };
+        var collect = Collect { .out = out };
+        self.forEachInRadius(x, y, radius, &collect);
+        if (collect.err) |e| return e;
+    }
+
+    // closest item within maxRadius of (x, y), searched ring by ring so the
+    // cost depends on the local density, not on maxRadius
+    pub fn nearest(self: Grid, x: f32, y: f32, maxRadius: f32, filter: anytype) ?u32 {
+        if (self.count() == 0) return null;
+
+        const Best = struct {
+            index: ?u32 = null,
+            d2: f32,
+            filter: @TypeOf(filter),
+
+            fn visit(best: *@This(), index: u32, d2: f32) void {
+                if (d2 < best.d2 and best.filter.accept(index)) {
+                    best.index = index;
+                    best.d2 = d2;
+                }
+            }
+        };
+        var best = Best { .d2 = maxRadius * maxRadius, .filter = filter };
+
+        const ccx = self.cellCoord(x);
+        const ccy = self.cellCoord(y);
+        const maxRing = @floatToInt(i32, std.math.ceil(maxRadius * self.invCellSize));
+        var ring: i32 = 0;
+        while (ring <= maxRing): (ring += 1) {
+            if (ring == 0) {
+                self.visitCell(ccx, ccy, x, y, best.d2, &best);
+            }
+            else {
+                var k: i32 = -ring;
+                while (k <= ring): (k += 1) {
+                    self.visitCell(ccx + k, ccy - ring, x, y, best.d2, &best);
+                    self.visitCell(ccx + k, ccy + ring, x, y, best.d2, &best);
+                }
+                k = -ring + 1;
+                while (k <= ring - 1): (k += 1) {
+                    self.visitCell(ccx - ring, ccy + k, x, y, best.d2, &best);
+                    self.visitCell(ccx + ring, ccy + k, x, y, best.d2, &best);
+                }
+            }
+
+            // anything beyond this ring is at least ring * cellSize away
+            const reach = @intToFloat(f32, ring) * self.cellSize;
+            if (best.index != null and best.d2 <= reach * reach) break;
+        }
+        return best.index;
+    }
+};
+
+// filter for nearest() that accepts every item
+pub const AcceptAll = struct {
+    pub fn accept(self: AcceptAll, index: u32) bool {
+        return true;
+    }
+};
+
+test "Grid.nearest" {
+    var grid = Grid.init(std.testing.allocator, 10.0);
+    defer grid.deinit();
+
+    const xs = [_]f32 { 0.0, 25.0, -40.0, 100.0 };
+    const ys = [_]f32 { 0.0, 5.0, -3.0, 100.0 };
+    try grid.build(&xs, &ys, std.testing.allocator);
+
+    assert(grid.nearest(21.0, 4.0, 50.0, AcceptAll{}).? == 1);
+    assert(grid.nearest(-33.0, 0.0, 50.0, AcceptAll{}).? == 2);
+    assert(grid.nearest(60.0, 60.0, 20.0, AcceptAll{}) == null);
+}
+
+test "Grid.queryRadius" {
+    var grid = Grid.init(std.testing.allocator, 4.0);
+    defer grid.deinit();
+
+    var xs: [100]f32 = undefined;
+    var ys: [100]f32 = undefined;
+    for (xs) |*x, i| {
+        x.* = @intToFloat(f32, i % 10) * 3.0;
+        ys[i] = @intToFloat(f32, i / 10) * 3.0;
+    }
+    try grid.build(&xs, &ys, std.testing.allocator);
+
+    var found = std.ArrayList(u32).init(std.testing.allocator);
+    defer found.deinit();
+    try grid.queryRadius(9.0, 9.0, 3.5, &found);
+
+    // the center point and its 4 direct neighbours
+    assert(found.items.len == 5);
+    for (found.items) |index| {
+        const dx = xs[index] - 9.0;
+        const dy = ys[index] - 9.0;
+        assert(dx * dx + dy * dy <= 3.5 * 3.5);
+    }
+}
+
+test "Grid.forEachInRect" {
+    var grid = Grid.init(std.testing.allocator, 4.0);
+    defer grid.deinit();
+
+    var xs: [100]f32 = undefined;
+    var ys: [100]f32 = undefined;
+    for (xs) |*x, i| {
+        x.* = @intToFloat(f32, i % 10) * 3.0;
+        ys[i] = @intToFloat(f32, i / 10) * 3.0;
+    }
+    try grid.build(&xs, &ys, std.testing.allocator);
+
+    const Count = struct {
+        n: usize = 0,
+        fn visit(c: *@This(), index: u32) void {
+            c.n += 1;
+        }
+    };
+
+    // 3x2 points, walks the cells
+    var small = Count{};
+    grid.forEachInRect(2.0, 2.0, 9.5, 7.0, &small);
+    assert(small.n == 6);
+
+    // more cells than items, scans
+    var all = Count{};
+    grid.forEachInRect(-1000.0, -1000.0, 1000.0, 1000.0, &all);
+    assert(all.n == 100);
+}
@@ -0,0 +1,77 @@
+//------------------------------------------------------------------------------
+//  handoff.zig
+//
+//  wait-free single producer / single consumer handoff
+//
+//  TripleBuffer(T) holds three T: the producer fills its back buffer and
+//  publishes it, the consumer picks up the latest published one. Both sides
+//  only ever do a single atomic exchange, so neither can block the other: a
+//  slow consumer just skips stale buffers, a slow producer leaves the
+//  consumer on the last one it published.
+//------------------------------------------------------------------------------
+const std = @import("std");
+const assert = std.debug.assert;
+
+pub fn TripleBuffer(comptime T: type) type {
+    return struct {
+        const Self = @This();
+        // middle holds the index of the shared buffer, plus this bit when
+        // the producer put something there the consumer hasn't taken yet
+        const fresh_bit: u32 = 4;
+        const index_mask: u32 = 3;
+
+        buffers: [3]T,
+        middle: u32 = 1,
+        back: u32 = 0, // producer only
+        front: u32 = 2, // consumer only
+
+        pub fn init(buffers: [3]T) Self {
+            return .{ .buffers = buffers };
+        }
+
+        // producer: the buffer to fill, stays ours until publish()
+        pub fn writeBuffer(self: *Self) *T {
+            return &self.buffers[self.back];
+        }
+
+        // producer: hands the back buffer over, gets the old middle one back
+        pub fn publish(self: *Self) void {
+            const old = @atomicRmw(u32, &self.middle, .Xchg, self.back | fresh_bit, .AcqRel);
+            self.back = old & index_mask;
+        }
+
+        // consumer: the most recently published buffer, valid until the next
+        // call; the same one again if nothing new was published
+        pub fn latest(self: *Self) *T {
+            if (@atomicLoad(u32, &self.middle, .Acquire) & fresh_bit != 0) {
+                const old = @atomicRmw(u32, &self.middle, .Xchg, self.front, .AcqRel);
+                self.front = old & index_mask;
+            }
+            return &self.buffers[self.front];
+        }
+    };
+}
+
+test "TripleBuffer hands over the latest value" {
+    var tb = TripleBuffer(u32).init(.{ 0, 0, 0 });
+
+    // nothing published yet
+    assert(tb.latest().* == 0);
+
+    tb.writeBuffer().* = 1;
+    tb.publish();
+    tb.writeBuffer().* = 2;
+    tb.publish();
+    // 1 was never read, the consumer skips to 2
+    assert(tb.latest().* == 2);
+    assert(tb.latest().* == 2);
+
+    tb.writeBuffer().* = 3;
+    tb.publish();
+    assert(tb.latest().* == 3);
+
+    // the three buffers are always distinct
+    assert(tb.back != tb.front);
+    assert(tb.back != tb.middle & 3);
+    assert(tb.front != tb.middle & 3);
+}
@@ -0,0 +1,524 @@
+//------------------------------------------------------------------------------
+//  jobs.zig
+//
+//  work-stealing job system
+//
+//  one worker per core, the thread that calls init() is worker 0 and only
+//  runs jobs while it waits on a counter. Every worker owns a Chase-Lev
+//  deque: it pushes and pops at the bottom, idle workers steal from the top.
+//  Completion is tracked with counters, and a small task graph on top runs
+//  tasks once all their dependencies are done. Workers which found nothing
+//  to do for a while park on a condition variable, submit() wakes one.
+//------------------------------------------------------------------------------
+const std = @import("std");
+const mem = std.mem;
+const assert = std.debug.assert;
+const prof = @import("prof.zig");
+
+// jobs in flight per worker, both the deque and the job ring use it
+const max_jobs = 4096;
+// failed job searches before an idle worker parks
+const idle_spins = 128;
+
+pub const JobFn = fn (ctx: usize, begin: usize, end: usize) void;
+
+const Job = struct {
+    func: JobFn,
+    ctx: usize,
+    begin: usize,
+    end: usize,
+    counter: *Counter,
+};
+
+// number of unfinished jobs, wait() on it to join
+pub const Counter = struct {
+    pending: u32 = 0,
+
+    pub fn isDone(self: *const Counter) bool {
+        return @atomicLoad(u32, &self.pending, .Acquire) == 0;
+    }
+
+    fn add(self: *Counter, n: u32) void {
+        _ = @atomicRmw(u32, &self.pending, .Add, n, .AcqRel);
+    }
+
+    fn done(self: *Counter) void {
+        _ = @atomicRmw(u32, &self.pending, .Sub, 1, .AcqRel);
+    }
+};
+
+// Chase-Lev deque, slots hold *Job as usize so they can be accessed atomically
+const Deque = struct {
+    const mask = max_jobs - 1;
+
+    slots: [max_jobs]usize = [_]usize{0} ** max_jobs,
+    top: isize = 0,
+    bottom: isize = 0,
+
+    // owner only
+    fn push(self: *Deque, job: *Job) void {
+        const b = @atomicLoad(isize, &self.bottom, .Monotonic);
+        const t = @atomicLoad(isize, &self.top, .Acquire);
+        assert(b - t < max_jobs);
+        @atomicStore(usize, &self.slots[@intCast(usize, b) & mask], @ptrToInt(job), .Monotonic);
+        @fence(.Release);
+        @atomicStore(isize, &self.bottom, b + 1, .Monotonic);
+    }
+
+    // owner only
+    fn pop(self: *Deque) ?*Job {
+        const b = @atomicLoad(isize, &self.bottom, .Monotonic) - 1;
+        @atomicStore(isize, &self.bottom, b, .Monotonic);
+        @fence(.SeqCst);
+        const t = @atomicLoad(isize, &self.top, .Monotonic);
+
+        if (t > b) {
+            // empty
+            @atomicStore(isize, &self.bottom, b + 1, .Monotonic);
+            return null;
+        }
+
+        const job = @intToPtr(*Job, @atomicLoad(usize, &self.slots[@intCast(usize, b) & mask], .Monotonic));
+        if (t < b) return job;
+
+        // last job, race the thieves for it
+        const won = @cmpxchgStrong(isize, &self.top, t, t + 1, .SeqCst, .Monotonic) == null;
+        @atomicStore(isize, &self.bottom, b + 1, .Monotonic);
+        return if (won) job else null;
+    }
+
+    // any thread, only a hint since the deque may change right after
+    fn isEmpty(self: *Deque) bool {
+        return @atomicLoad(isize, &self.top, .Acquire) >= @atomicLoad(isize, &self.bottom, .Acquire);
+    }
+
+    // any thread
+    fn steal(self: *Deque) ?*Job {
+        const t = @atomicLoad(isize, &self.top, .Acquire);
+        @fence(.SeqCst);
+        const b = @atomicLoad(isize, &self.bottom, .Acquire);
+        if (t >= b) return null;
+
+        const job = @intToPtr(*Job, @atomicLoad(usize, &self.slots[@intCast(usize, t) & mask], .Monotonic));
+        if (@cmpxchgStrong(isize, &self.top, t, t + 1, .SeqCst, .Monotonic) != null) {
+            return null;
+        }
+        return job;
+    }
+};
+
+const Worker = struct {
+    system: *JobSystem,
+    index: usize,
+    thread: ?*std.Thread = null,
+    deque: Deque = .{},
+    // jobs are recycled in order, a slot is free again long before the ring
+    // wraps because the deque never holds more than max_jobs
+    ring: [max_jobs]Job = undefined,
+    ringNext: usize = 0,
+
+    fn allocJob(self: *Worker) *Job {
+        const job = &self.ring[self.ringNext & (max_jobs - 1)];
+        self.ringNext +%= 1;
+        return job;
+    }
+};
+
+threadlocal var tls_worker: ?*Worker = null;
+
+pub const JobSystem = struct {
+    allocator: *mem.Allocator,
+    workers: []Worker,
+    running: bool = true,
+    // parked workers, see park() and wakeOne()
+    parkMutex: std.Thread.Mutex = .{},
+    parkCond: std.Thread.Condition = .{},
+    sleeping: u32 = 0,
+
+    // workerCount 0 picks one worker per core
+    pub fn init(allocator: *mem.Allocator, workerCount: usize) !*JobSystem {
+        const count = if (workerCount > 0) workerCount else std.Thread.getCpuCount() catch 1;
+
+        var self = try allocator.create(JobSystem);
+        errdefer allocator.destroy(self);
+        self.* = .{
+            .allocator = allocator,
+            .workers = try allocator.alloc(Worker, count),
+        };
+        for (self.workers) |*worker, i| {
+            worker.* = .{ .system = self, .index = i };
+        }
+
+        tls_worker = &self.workers[0];
+        for (self.workers[1..]) |*worker| {
+            worker.thread = try std.Thread.spawn(workerMain, worker);
+        }
+        return self;
+    }
+
+    pub fn deinit(self: *JobSystem) void {
+        @atomicStore(bool, &self.running, false, .SeqCst);
+        {
+            const held = self.parkMutex.acquire();
+            defer held.release();
+            self.parkCond.broadcast();
+        }
+        for (self.workers[1..]) |*worker| {
+            if (worker.thread) |thread| thread.wait();
+        }
+        tls_worker = null;
+        self.allocator.free(self.workers);
+        self.allocator.destroy(self);
+    }
+
+    pub fn workerCount(self: *const JobSystem) usize {
+        return self.workers.len;
+    }
+
+    fn current(self: *JobSystem) *Worker {
+        const worker = tls_worker orelse unreachable; // not a worker thread
+        assert(worker.system == self);
+        return worker;
+    }
+
+    pub fn submit(self: *JobSystem, counter: *Counter, func: JobFn, ctx: usize, begin: usize, end: usize) void {
+        const worker = self.current();
+        const job = worker.allocJob();
+        job.* = .{ .func = func, .ctx = ctx, .begin = begin, .end = end, .counter = counter };
+        counter.add(1);
+        worker.deque.push(job);
+        self.wakeOne();
+    }
+
+    fn hasWork(self: *JobSystem) bool {
+        for (self.workers) |*worker| {
+            if (!worker.deque.isEmpty()) return true;
+        }
+        return false;
+    }
+
+    // sleeps until submit() or deinit() wakes it up. sleeping is raised
+    // before looking at the deques and submit() looks at it after pushing,
+    // so either the worker sees the job or submit() sees the worker
+    fn park(self: *JobSystem) void {
+        const held = self.parkMutex.acquire();
+        defer held.release();
+        _ = @atomicRmw(u32, &self.sleeping, .Add, 1, .SeqCst);
+        @fence(.SeqCst);
+        if (@atomicLoad(bool, &self.running, .SeqCst) and !self.hasWork()) {
+            self.parkCond.wait(&self.parkMutex);
+        }
+        _ = @atomicRmw(u32, &self.sleeping, .Sub, 1, .SeqCst);
+    }
+
+    fn wakeOne(self: *JobSystem) void {
+        @fence(.SeqCst);
+        if (@atomicLoad(u32, &self.sleeping, .SeqCst) == 0) return;
+        const held = self.parkMutex.acquire();
+        defer held.release();
+        self.parkCond.signal();
+    }
+
+    fn findJob(self: *JobSystem, worker: *Worker) ?*Job {
+        if (worker.deque.pop()) |job| return job;
+
+        // steal round robin, starting with the next worker
+        var i: usize = 1;
+        while (i < self.workers.len): (i += 1) {
+            const victim = &self.workers[(worker.index + i) % self.workers.len];
+            if (victim.deque.steal()) |job| return job;
+        }
+        return null;
+    }
+
+    fn execute(job: *Job) void {
+        // copy out first, the ring slot may be recycled while we run
+        const j = job.*;
+        j.func(j.ctx, j.begin, j.end);
+        j.counter.done();
+    }
+
+    // runs other jobs until the counter drops to zero
+    pub fn wait(self: *JobSystem, counter: *Counter) void {
+        const worker = self.current();
+        while (!counter.isDone()) {
+            if (self.findJob(worker)) |job| {
+                execute(job);
+            }
+            else {
+                std.os.sched_yield() catch {};
+            }
+        }
+    }
+
+    // splits [0, count) into chunks of about grain items and runs
+    // func(context, begin, end) on all cores, returns once every chunk ran
+    pub fn parallelFor(self: *JobSystem, count: usize, grain: usize, context: anytype, comptime func: fn (@TypeOf(context), usize, usize) void) void {
+        if (count == 0) return;
+        const Context = @TypeOf(context);
+        const Wrap = struct {
+            fn run(ctx: usize, begin: usize, end: usize) void {
+                func(@intToPtr(Context, ctx), begin, end);
+            }
+        };
+
+        // no more chunks than a few per worker, no less than grain items each
+        const minChunk = (count + self.workers.len * 4 - 1) / (self.workers.len * 4);
+        const chunk = std.math.max(std.math.max(grain, minChunk), 1);
+        if (chunk >= count) {
+            func(context, 0, count);
+            return;
+        }
+
+        var counter = Counter{};
+        var begin: usize = 0;
+        while (begin < count): (begin += chunk) {
+            self.submit(&counter, Wrap.run, @ptrToInt(context), begin, std.math.min(begin + chunk, count));
+        }
+        self.wait(&counter);
+    }
+};
+
+fn workerMain(worker: *Worker) void {
+    tls_worker = worker;
+    const system = worker.system;
+    var nameBuf: [16]u8 = undefined;
+    prof.setThreadName(std.fmt.bufPrint(&nameBuf, "worker {d}", .{ worker.index }) catch "worker");
+
+    var idle: u32 = 0;
+    while (@atomicLoad(bool, &system.running, .Acquire)) {
+        if (system.findJob(worker)) |job| {
+            JobSystem.execute(job);
+            idle = 0;
+        }
+        else if (idle < idle_spins) {
+            idle += 1;
+            std.os.sched_yield() catch {};
+        }
+        else {
+            // long idle (between ticks), give the core back until there is work
+            system.park();
+            idle = 0;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//  task graph
+//------------------------------------------------------------------------------
+pub const TaskId = u32;
+
+pub const max_tasks = 32;
+const max_dependents = 8;
+
+const Task = struct {
+    name: []const u8,
+    func: fn (ctx: usize) void,
+    ctx: usize,
+    depCount: u32 = 0,
+    pendingDeps: u32 = 0,
+    dependents: [max_dependents]TaskId = undefined,
+    dependentCount: u32 = 0,
+    // stm ticks, filled in by run() for profiling
+    startTicks: u64 = 0,
+    endTicks: u64 = 0,
+};
+
+// a fixed set of tasks with dependencies, built once and run every tick
+pub const Graph = struct {
+    tasks: [max_tasks]Task = undefined,
+    count: u32 = 0,
+    system: ?*JobSystem = null,
+    counter: Counter = .{},
+    clock: ?fn () u64 = null,
+
+    pub fn add(self: *Graph, name: []const u8, context: anytype, comptime func: fn (@TypeOf(context)) void, deps: []const TaskId) TaskId {
+        assert(self.count < max_tasks);
+        const Context = @TypeOf(context);
+        const Wrap = struct {
+            fn run(ctx: usize) void {
+                func(@intToPtr(Context, ctx));
+            }
+        };
+
+        const id = self.count;
+        self.tasks[id] = .{
+            .name = name,
+            .func = Wrap.run,
+            .ctx = @ptrToInt(context),
+            .depCount = @intCast(u32, deps.len),
+        };
+        for (deps) |dep| {
+            assert(dep < id);
+            const parent = &self.tasks[dep];
+            assert(parent.dependentCount < max_dependents);
+            parent.dependents[parent.dependentCount] = id;
+            parent.dependentCount += 1;
+        }
+        self.count += 1;
+        return id;
+    }
+
+    pub fn taskName(self: *const Graph, id: TaskId) []const u8 {
+        return self.tasks[id].name;
+    }
+
+    // time spent in a task during the last run, in clock ticks
+    pub fn taskTicks(self: *const Graph, id: TaskId) u64 {
+        return self.tasks[id].endTicks -% self.tasks[id].startTicks;
+    }
+
+    fn runTask(ctx: usize, taskIndex: usize, unused: usize) void {
+        const self = @intToPtr(*Graph, ctx);
+        const task = &self.tasks[taskIndex];
+
+        const zone = prof.begin(task.name);
+        if (self.clock) |clock| task.startTicks = clock();
+        task.func(task.ctx);
+        if (self.clock) |clock| task.endTicks = clock();
+        zone.end();
+
+        // last finished dependency schedules the dependent
+        for (task.dependents[0..task.dependentCount]) |id| {
+            if (@atomicRmw(u32, &self.tasks[id].pendingDeps, .Sub, 1, .AcqRel) == 1) {
+                self.system.?.submit(&self.counter, runTask, ctx, id, 0);
+            }
+        }
+    }
+
+    // runs every task once, in dependency order, and waits for all of them
+    pub fn run(self: *Graph, system: *JobSystem) void {
+        self.system = system;
+        for (self.tasks[0..self.count]) |*task| {
+            task.pendingDeps = task.depCount;
+        }
+        for (self.tasks[0..self.count]) |task, id| {
+            if (task.depCount == 0) {
+                system.submit(&self.counter, runTask, @ptrToInt(self), id, 0);
+            }
+        }
+        system.wait(&self.counter);
+    }
+};
+
+//------------------------------------------------------------------------------
+//  tests
+//------------------------------------------------------------------------------
+const TestThief = struct {
+    deque: *Deque,
+    taken: []u32,
+    stop: bool = false,
+
+    fn main(self: *TestThief) void {
+        while (!@atomicLoad(bool, &self.stop, .Acquire)) {
+            if (self.deque.steal()) |job| {
+                _ = @atomicRmw(u32, &self.taken[job.ctx], .Add, 1, .Monotonic);
+            }
+        }
+    }
+};
+
+test "Deque hands every job out once, to its owner or a thief" {
+    var deque = Deque{};
+    var jobs: [3000]Job = undefined;
+    var taken = [_]u32{0} ** jobs.len;
+    var thief = TestThief{ .deque = &deque, .taken = &taken };
+    var threads: [3]*std.Thread = undefined;
+    for (threads) |*thread| {
+        thread.* = try std.Thread.spawn(TestThief.main, &thief);
+    }
+
+    // the owner pops some as it goes, the thieves race it for the rest
+    for (jobs) |*job, i| {
+        job.ctx = i;
+        deque.push(job);
+        if (i % 3 == 0) {
+            if (deque.pop()) |popped| _ = @atomicRmw(u32, &taken[popped.ctx], .Add, 1, .Monotonic);
+        }
+    }
+    while (deque.pop()) |popped| {
+        _ = @atomicRmw(u32, &taken[popped.ctx], .Add, 1, .Monotonic);
+    }
+
+    @atomicStore(bool, &thief.stop, true, .Release);
+    for (threads) |thread| thread.wait();
+    for (taken) |count| assert(count == 1);
+}
+
+const TestVisits = struct {
+    counts: []u32,
+
+    fn visit(self: *TestVisits, begin: usize, end: usize) void {
+        for (self.counts[begin..end]) |*count| {
+            _ = @atomicRmw(u32, count, .Add, 1, .Monotonic);
+        }
+    }
+};
+
+test "parallelFor visits every index exactly once" {
+    const system = try JobSystem.init(std.testing.allocator, 4);
+    defer system.deinit();
+
+    var counts = [_]u32{0} ** 10007;
+    for ([_]usize{ 1, 3, 100, 1000, counts.len }) |count| {
+        for ([_]usize{ 1, 7, 4096 }) |grain| {
+            mem.set(u32, &counts, 0);
+            var visits = TestVisits{ .counts = counts[0..count] };
+            system.parallelFor(count, grain, &visits, TestVisits.visit);
+            for (counts[0..count]) |visited| assert(visited == 1);
+            for (counts[count..]) |visited| assert(visited == 0);
+        }
+    }
+}
+
+// a diamond, an independent task and a join:
+// 0 -> 1, 2 -> 3, and 3, 4 -> 5
+const test_graph_deps = [_][]const TaskId{
+    &[_]TaskId{},
+    &[_]TaskId{ 0 },
+    &[_]TaskId{ 0 },
+    &[_]TaskId{ 1, 2 },
+    &[_]TaskId{},
+    &[_]TaskId{ 3, 4 },
+};
+
+const TestGraph = struct {
+    round: u32 = 0,
+    runs: [test_graph_deps.len]u32 = [_]u32{0} ** test_graph_deps.len,
+};
+
+const TestNode = struct {
+    graph: *TestGraph,
+    id: TaskId,
+
+    // every dependency already ran this round, this task not yet
+    fn run(self: *TestNode) void {
+        const round = @atomicLoad(u32, &self.graph.round, .Acquire);
+        for (test_graph_deps[self.id]) |dep| {
+            assert(@atomicLoad(u32, &self.graph.runs[dep], .Acquire) == round);
+        }
+        const previous = @atomicRmw(u32, &self.graph.runs[self.id], .Add, 1, .AcqRel);
+        assert(previous == round - 1);
+    }
+};
+
+test "Graph.run runs every task once, after its dependencies, run after run" {
+    const system = try JobSystem.init(std.testing.allocator, 4);
+    defer system.deinit();
+
+    var state = TestGraph{};
+    var nodes: [test_graph_deps.len]TestNode = undefined;
+    var graph = Graph{};
+    for (nodes) |*node, i| {
+        node.* = .{ .graph = &state, .id = @intCast(TaskId, i) };
+        assert(graph.add("test", node, TestNode.run, test_graph_deps[i]) == i);
+    }
+
+    // pending dependency counts are reset by every run
+    var round: u32 = 1;
+    while (round <= 100): (round += 1) {
+        @atomicStore(u32, &state.round, round, .Release);
+        graph.run(system);
+        for (state.runs) |runs| assert(runs == round);
+    }
+}
@@ -0,0 +1,334 @@
+//------------------------------------------------------------------------------
+//  kernels.zig
+//
+//  agent integration kernels over the SoA columns
+//
+//  each kernel has a scalar reference version and a @Vector version doing
+//  the exact same float operations per lane, so both give bit identical
+//  results (checked by the tests below, timed by bench.zig)
+//------------------------------------------------------------------------------
+const std = @import("std");
+const assert = std.debug.assert;
+
+// 8 x f32 fills an AVX register, 16 works as well on AVX-512
+pub const lanes = 8;
+
+pub const MoveColumns = struct {
+    posX: []f32,
+    posY: []f32,
+    prevX: []f32,
+    prevY: []f32,
+    velX: []const f32,
+    velY: []const f32,
+};
+
+pub const MoveParams = struct {
+    dt: f32,
+    worldHalf: f32, // positions wrap around [-worldHalf, worldHalf]
+};
+
+fn wrapCoord(v: f32, half: f32) f32 {
+    if (v > half) return v - half * 2.0;
+    if (v < -half) return v + half * 2.0;
+    return v;
+}
+
+// prev = pos, pos += vel * dt, wrapped agents don't interpolate (prev = pos)
+fn moveOne(c: MoveColumns, p: MoveParams, i: usize) void {
+    c.prevX[i] = c.posX[i];
+    c.prevY[i] = c.posY[i];
+    c.posX[i] += c.velX[i] * p.dt;
+    c.posY[i] += c.velY[i] * p.dt;
+    if (std.math.fabs(c.posX[i]) > p.worldHalf or std.math.fabs(c.posY[i]) > p.worldHalf) {
+        c.posX[i] = wrapCoord(c.posX[i], p.worldHalf);
+        c.posY[i] = wrapCoord(c.posY[i], p.worldHalf);
+        c.prevX[i] = c.posX[i];
+        c.prevY[i] = c.posY[i];
+    }
+}
+
+pub fn moveScalar(c: MoveColumns, p: MoveParams) void {
+    var i: usize = 0;
+    while (i < c.posX.len): (i += 1) {
+        moveOne(c, p, i);
+    }
+}
+
+pub fn moveSimd(comptime N: usize, c: MoveColumns, p: MoveParams) void {
+    const V = @Vector(N, f32);
+    const dt = @splat(N, p.dt);
+    const half = @splat(N, p.worldHalf);
+    const len = c.posX.len;
+
+    var i: usize = 0;
+    while (i + N <= len): (i += N) {
+        const x: V = c.posX[i..][0..N].*;
+        const y: V = c.posY[i..][0..N].*;
+        const vx: V = c.velX[i..][0..N].*;
+        const vy: V = c.velY[i..][0..N].*;
+        const nx = x + vx * dt;
+        const ny = y + vy * dt;
+
+        // wrapping is rare, such blocks take the scalar path
+        const outside = @reduce(.Or, nx > half) or @reduce(.Or, nx < -half) or
+                        @reduce(.Or, ny > half) or @reduce(.Or, ny < -half);
+        if (outside) {
+            var j = i;
+            while (j < i + N): (j += 1) {
+                moveOne(c, p, j);
+            }
+            continue;
+        }
+
+        c.prevX[i..][0..N].* = x;
+        c.prevY[i..][0..N].* = y;
+        c.posX[i..][0..N].* = nx;
+        c.posY[i..][0..N].* = ny;
+    }
+
+    // remainder
+    while (i < len): (i += 1) {
+        moveOne(c, p, i);
+    }
+}
+
+pub fn decayScalar(energy: []f32, amount: f32) void {
+    for (energy) |*e| {
+        e.* -= amount;
+    }
+}
+
+pub fn decaySimd(comptime N: usize, energy: []f32, amount: f32) void {
+    const V = @Vector(N, f32);
+    const a = @splat(N, amount);
+    const len = energy.len;
+
+    var i: usize = 0;
+    while (i + N <= len): (i += N) {
+        const e: V = energy[i..][0..N].*;
+        energy[i..][0..N].* = e - a;
+    }
+    decayScalar(energy[i..], amount);
+}
+
+pub const Rect = struct {
+    minX: f32,
+    minY: f32,
+    maxX: f32,
+    maxY: f32,
+};
+
+pub const CullColumns = struct {
+    posX: []const f32,
+    posY: []const f32,
+    prevX: []const f32,
+    prevY: []const f32,
+};
+
+fn visibleOne(c: CullColumns, alpha: f32, r: Rect, i: usize) bool {
+    const x = c.prevX[i] + (c.posX[i] - c.prevX[i]) * alpha;
+    const y = c.prevY[i] + (c.posY[i] - c.prevY[i]) * alpha;
+    return x >= r.minX and x <= r.maxX and y >= r.minY and y <= r.maxY;
+}
+
+// writes the index of every agent whose interpolated position is inside r
+// to out (at least as long as the columns), returns the visible count
+pub fn cullScalar(c: CullColumns, alpha: f32, r: Rect, out: []u32) usize {
+    var count: usize = 0;
+    var i: usize = 0;
+    while (i < c.posX.len): (i += 1) {
+        if (visibleOne(c, alpha, r, i)) {
+            out[count] = @intCast(u32, i);
+            count += 1;
+        }
+    }
+    return count;
+}
+
+pub fn cullSimd(comptime N: usize, c: CullColumns, alpha: f32, r: Rect, out: []u32) usize {
+    const V = @Vector(N, f32);
+    const a = @splat(N, alpha);
+    const minX = @splat(N, r.minX);
+    const minY = @splat(N, r.minY);
+    const maxX = @splat(N, r.maxX);
+    const maxY = @splat(N, r.maxY);
+    const len = c.posX.len;
+
+    var count: usize = 0;
+    var i: usize = 0;
+    while (i + N <= len): (i += N) {
+        const px: V = c.prevX[i..][0..N].*;
+        const py: V = c.prevY[i..][0..N].*;
+        const cx: V = c.posX[i..][0..N].*;
+        const cy: V = c.posY[i..][0..N].*;
+        const x = px + (cx - px) * a;
+        const y = py + (cy - py) * a;
+
+        // compares run on whole vectors, only the compaction is per lane
+        const left = x < minX;
+        const right = x > maxX;
+        const above = y < minY;
+        const below = y > maxY;
+        comptime var lane: usize = 0;
+        inline while (lane < N): (lane += 1) {
+            if (!(left[lane] or right[lane] or above[lane] or below[lane])) {
+                out[count] = @intCast(u32, i + lane);
+                count += 1;
+            }
+        }
+    }
+
+    // remainder
+    while (i < len): (i += 1) {
+        if (visibleOne(c, alpha, r, i)) {
+            out[count] = @intCast(u32, i);
+            count += 1;
+        }
+    }
+    return count;
+}
+
+// adds one to the cell under every position; cells is res * res, row major,
+// covering [-worldHalf, worldHalf] on both axes, outside positions are clamped
+pub fn binDensity(xs: []const f32, ys: []const f32, worldHalf: f32, res: u32, cells: []u32) void {
+    assert(xs.len == ys.len and cells.len == res * res);
+    const scale = @intToFloat(f32, res) / (worldHalf * 2.0);
+    const last = @intToFloat(f32, res - 1);
+    for (xs) |x, i| {
+        const cx = std.math.clamp((x + worldHalf) * scale, 0.0, last);
+        const cy = std.math.clamp((ys[i] + worldHalf) * scale, 0.0, last);
+        cells[@floatToInt(u32, cy) * res + @floatToInt(u32, cx)] += 1;
+    }
+}
+
+//------------------------------------------------------------------------------
+//  SIMD vs scalar equivalence
+//------------------------------------------------------------------------------
+const TestAgents = struct {
+    posX: []f32,
+    posY: []f32,
+    prevX: []f32,
+    prevY: []f32,
+    velX: []f32,
+    velY: []f32,
+    energy: []f32,
+
+    fn init(allocator: *std.mem.Allocator, n: usize, seed: u64) !TestAgents {
+        var prng = std.rand.DefaultPrng.init(seed);
+        const random = &prng.random;
+        var agents: TestAgents = undefined;
+        inline for (std.meta.fields(TestAgents)) |field| {
+            const column = try allocator.alloc(f32, n);
+            for (column) |*v| {
+                // some agents start close enough to the edge to wrap
+                v.* = (random.float(f32) - 0.5) * 205.0;
+            }
+            @field(agents, field.name) = column;
+        }
+        return agents;
+    }
+
+    fn clone(self: TestAgents, allocator: *std.mem.Allocator) !TestAgents {
+        var agents: TestAgents = undefined;
+        inline for (std.meta.fields(TestAgents)) |field| {
+            @field(agents, field.name) = try allocator.dupe(f32, @field(self, field.name));
+        }
+        return agents;
+    }
+
+    fn deinit(self: TestAgents, allocator: *std.mem.Allocator) void {
+        inline for (std.meta.fields(TestAgents)) |field| {
+            allocator.free(@field(self, field.name));
+        }
+    }
+
+    fn columns(self: TestAgents) MoveColumns {
+        return .{
+            .posX = self.posX, .posY = self.posY,
+            .prevX = self.prevX, .prevY = self.prevY,
+            .velX = self.velX, .velY = self.velY,
+        };
+    }
+
+    fn expectEqual(a: TestAgents, b: TestAgents) void {
+        inline for (std.meta.fields(TestAgents)) |field| {
+            for (@field(a, field.name)) |v, i| {
+                assert(@bitCast(u32, v) == @bitCast(u32, @field(b, field.name)[i]));
+            }
+        }
+    }
+};
+
+test "moveSimd matches moveScalar, remainders included" {
+    const allocator = std.testing.allocator;
+    const params = MoveParams { .dt = 1.0 / 60.0, .worldHalf = 100.0 };
+
+    var n: usize = 0;
+    while (n < 3 * 16 + 1): (n += 1) {
+        const ref = try TestAgents.init(allocator, n, n);
+        defer ref.deinit(allocator);
+        const simd8 = try ref.clone(allocator);
+        defer simd8.deinit(allocator);
+        const simd16 = try ref.clone(allocator);
+        defer simd16.deinit(allocator);
+
+        moveScalar(ref.columns(), params);
+        moveSimd(8, simd8.columns(), params);
+        moveSimd(16, simd16.columns(), params);
+        TestAgents.expectEqual(ref, simd8);
+        TestAgents.expectEqual(ref, simd16);
+    }
+}
+
+test "cullSimd matches cullScalar, remainders included" {
+    const allocator = std.testing.allocator;
+    const rect = Rect { .minX = -30.0, .minY = -50.0, .maxX = 60.0, .maxY = 20.0 };
+
+    var n: usize = 0;
+    while (n < 3 * 16 + 1): (n += 1) {
+        const agents = try TestAgents.init(allocator, n, n);
+        defer agents.deinit(allocator);
+        const columns = CullColumns {
+            .posX = agents.posX, .posY = agents.posY,
+            .prevX = agents.prevX, .prevY = agents.prevY,
+        };
+
+        var ref = try allocator.alloc(u32, n);
+        defer allocator.free(ref);
+        var simd = try allocator.alloc(u32, n);
+        defer allocator.free(simd);
+
+        const refCount = cullScalar(columns, 0.3, rect, ref);
+        assert(cullSimd(8, columns, 0.3, rect, simd) == refCount);
+        assert(std.mem.eql(u32, ref[0..refCount], simd[0..refCount]));
+        assert(cullSimd(16, columns, 0.3, rect, simd) == refCount);
+        assert(std.mem.eql(u32, ref[0..refCount], simd[0..refCount]));
+    }
+}
+
+test "decaySimd matches decayScalar, remainders included" {
+    const allocator = std.testing.allocator;
+
+    var n: usize = 0;
+    while (n < 3 * 16 + 1): (n += 1) {
+        const ref = try TestAgents.init(allocator, n, n);
+        defer ref.deinit(allocator);
+        const simd = try ref.clone(allocator);
+        defer simd.deinit(allocator);
+
+        decayScalar(ref.energy, 0.25);
+        decaySimd(lanes, simd.energy, 0.25);
+        TestAgents.expectEqual(ref, simd);
+    }
+}
+
+test "binDensity counts positions per cell" {
+    const xs = [_]f32{ -100.0, -99.0, 99.0, 0.0, 1000.0 };
+    const ys = [_]f32{ -100.0, -40.0, 99.0, 0.0, -1000.0 };
+    var cells = [_]u32{0} ** 16;
+    binDensity(&xs, &ys, 100.0, 4, &cells);
+    assert(cells[0] == 1 and cells[4] == 1); // first column, rows 0 and 1
+    assert(cells[15] == 1);
+    assert(cells[2 * 4 + 2] == 1);
+    assert(cells[3] == 1); // clamped into the top right corner
+}
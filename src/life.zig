@@ -2,8 +2,24 @@ const std   = @import("std");
 const sg    = @import("sokol").gfx;
 const sapp  = @import("sokol").app;
 const sgapp = @import("sokol").app_gfx_glue;
-const shd   = @import("shaders/color.glsl.zig");
+const stm   = @import("sokol").time;
+const sdtx  = @import("sokol").debugtext;
+const shd   = @import("shaders/sprite.glsl.zig");
 const math  = @import("math.zig");
+const assets = @import("assets.zig");
+const entity = @import("entity.zig");
+const grid   = @import("grid.zig");
+const jobs   = @import("jobs.zig");
+const kernels = @import("kernels.zig");
+const atlas  = @import("atlas"); // generated by tools/bake_assets.zig
+const pack   = @import("pack.zig");
+const snapshot = @import("snapshot.zig");
+const arena  = @import("arena.zig");
+const handoff = @import("handoff.zig");
+const prof   = @import("prof.zig");
+const sprite = @import("sprite.zig");
+const chunks = @import("chunks.zig");
+const replay = @import("replay.zig");
 const vec2 = math.Vec2;
 const vec3 = math.Vec3;
 const mat4 = math.Mat4;
@@ -12,75 +28,220 @@ const Array = std.ArrayList;
 var gpa = std.heap.GeneralPurposeAllocator(.{}){};
 var global_allocator = &gpa.allocator;
 
-const ImageEntry = struct {
-    path: []const u8
+const ImageID = assets.ImageID;
+
+const Camera = struct {
+    pos: vec2 = vec2.zero(),
+    zoom: f32 = 1.0,
 };
 
-const g_ImageList = [_]ImageEntry {
-    .{ .path = "data/bouffe.png" },
+const RenderCommandSprite = sprite.RenderCommandSprite;
+const SpriteInstance = sprite.SpriteInstance;
+
+const Renderer = struct {
+    cam: Camera = .{},
+    frameIndex: u32 = 0,
+    // everything transient lives in the frame arenas, see arena.zig
+    frameArenas: arena.FrameArenas,
+    frameAllocator: *std.mem.Allocator = undefined,
+    queueSprite: Array(RenderCommandSprite) = undefined,
+    // sent to the sim thread every frame
+    feedback: RenderFeedback = .{},
+    // profiler overlay, the summary is refreshed every PROF_OVERLAY_INTERVAL
+    showProfiler: bool = false,
+    profStats: []prof.ZoneStat = &[_]prof.ZoneStat{},
+    profWindowStart: u64 = 0,
+    profWindowSec: f64 = 1.0,
+    spriteBuffer: sg.Buffer = .{},
+    spriteBufferCapacity: usize = 0,
+    // baked food, one immutable instance buffer per world chunk
+    foodChunks: [FOOD_CHUNK_COUNT]FoodChunk = [_]FoodChunk{ .{} } ** FOOD_CHUNK_COUNT,
+    // zoomed out level of detail: the whole world as one textured quad
+    densityImage: sg.Image = .{},
+    densityQuad: sg.Buffer = .{},
+    densitySeq: u64 = 0, // batch the image was last uploaded from
+    zoomRestores: u32 = 0, // last SpriteBatch.zoomRestores adopted
+    atlas: sg.Image = .{},
 };
 
-// image "hash"
-const ImageID = struct {
-    u: u32,
+const FoodChunk = struct {
+    buffer: sg.Buffer = .{},
+    count: u32 = 0,
+    version: u64 = 0, // publication it was baked from, see chunks.zig
+    bounds: kernels.Rect = .{ .minX = 0, .minY = 0, .maxX = 0, .maxY = 0 },
+};
 
-    fn fromPath(comptime path: []const u8) ImageID
-    {
-        comptime var id: ImageID = .{ .u = 1 };
+// a food chunk to rebake, its instances are in SpriteBatch.chunkSprites
+const ChunkUpdate = struct {
+    chunk: u32,
+    version: u64,
+    bounds: kernels.Rect, // chunk rect grown by the sprite size
+    first: u32,
+    count: u32,
+};
 
-        for(g_ImageList) |entry| {
-            if(StringEquals(entry.path, path)) {
-                return id;
-            }
+// one published simulation tick, everything the renderer needs to draw it
+// without touching the game state (sprites are already culled)
+const SpriteBatch = struct {
+    sprites: Array(RenderCommandSprite), // at the current tick
+    prevPos: Array(vec2), // same order, at the previous tick
+    // food chunks changed since the last batch the renderer baked from
+    seq: u64 = 0,
+    chunkUpdates: Array(ChunkUpdate),
+    chunkSprites: Array(SpriteInstance),
+    // zoomed out: no agent sprites, density holds DENSITY_RES^2 RGBA8 texels
+    densityLod: bool = false,
+    density: Array(u32),
+    prevZoom: f32 = 1.0,
+    curZoom: f32 = 1.0,
+    // bumped when a snapshot restores the zoom, the renderer then takes
+    // inputZoom as its own so its feedback doesn't undo the restore
+    zoomRestores: u32 = 0,
+    inputZoom: f32 = 1.0,
+    time: u64 = 0, // stm ticks at publish time, drives the interpolation
 
-            id.u += 1;
-        }
+    fn init(allocator: *std.mem.Allocator) SpriteBatch
+    {
+        return .{
+            .sprites = Array(RenderCommandSprite).init(allocator),
+            .prevPos = Array(vec2).init(allocator),
+            .chunkUpdates = Array(ChunkUpdate).init(allocator),
+            .chunkSprites = Array(SpriteInstance).init(allocator),
+            .density = Array(u32).init(allocator),
+        };
+    }
 
-        unreachable;
+    fn clear(self: *SpriteBatch) void
+    {
+        self.sprites.clearRetainingCapacity();
+        self.prevPos.clearRetainingCapacity();
+        self.chunkUpdates.clearRetainingCapacity();
+        self.chunkSprites.clearRetainingCapacity();
     }
 };
 
-fn StringEquals(str1: []const u8, str2: []const u8) bool 
-{
-    if(str1.len != str2.len) return false;
+// what the render thread tells the sim thread, the request counters are
+// compared with the ones the sim already handled
+const RenderFeedback = struct {
+    view: kernels.Rect = .{ .minX = -WORLD_SIZE, .minY = -WORLD_SIZE, .maxX = WORLD_SIZE, .maxY = WORLD_SIZE },
+    zoom: f32 = 1.0,
+    saveRequests: u32 = 0,
+    loadRequests: u32 = 0,
+    chunkSeq: u64 = 0, // last batch whose food chunks were baked
+};
 
-    comptime var i = 0;
-    while(i < str1.len) {
-        if(str1[i] != str2[i]) return false;
-        i += 1;
-    }
-    return true;
-}
+// starting sizes, both grow to their high water mark when they overflow
+const FRAME_ARENA_SIZE = 4 * 1024 * 1024;
+const TICK_ARENA_SIZE = 1024 * 1024;
 
-const Camera = struct {
-    pos: vec2 = vec2.zero(),
-    zoom: f32 = 1.0,
+const Input = struct {
+    zoom: f32 = 1.0
 };
 
-const RenderCommandSprite = struct {
-    pos: vec2,
-    scale: vec2 = vec2.new(1, 1),
-    rot: f32 = 0,
-    color: u32 = 0xFFFFFFFF,
-    imgID: ImageID,
+// fixed simulation rate, independent from the display refresh rate
+const SIM_TICK_RATE = 60.0;
+const SIM_DT = 1.0 / SIM_TICK_RATE;
+// ticks run per frame at most, the rest of the backlog is dropped so a slow
+// frame can't snowball into ever longer catch-up frames
+const SIM_MAX_CATCHUP_TICKS = 5;
+
+// everything the renderer interpolates between two ticks
+// (agents keep their previous position in their own columns)
+const SimState = struct {
+    camZoom: f32 = 1.0,
 };
 
-const Renderer = struct {
-    cam: Camera = .{},
-    queueSprite: Array(RenderCommandSprite),
+const WORLD_SIZE = 4096.0;
+const WORLD_HALF = WORLD_SIZE / 2.0;
+const AGENT_START_COUNT = 1000;
+const AGENT_SPEED = 40.0; // units per second
+const AGENT_ENERGY_DECAY = 1.0; // per second
+const AGENT_SIGHT = 150.0;
+const AGENT_EAT_RADIUS = 8.0;
+const AGENT_REPRODUCE_ENERGY = 150.0;
+const FOOD_START_COUNT = 2000;
+const FOOD_SPAWN_RATE = 20.0; // per second
+const FOOD_ENERGY = 20.0;
+// tunable, best around the typical query radius
+const FOOD_GRID_CELL_SIZE = AGENT_SIGHT;
+// food is drawn from per chunk buffers, WORLD_SIZE is a multiple of this
+const FOOD_CHUNK_SIZE = 512.0;
+const FOOD_CHUNK_SIDE = @floatToInt(u32, WORLD_SIZE / FOOD_CHUNK_SIZE);
+const FOOD_CHUNK_COUNT = FOOD_CHUNK_SIDE * FOOD_CHUNK_SIDE;
+// zoomed out until agents are narrower than this many pixels, the world is
+// drawn as a density heatmap instead of sprites
+const DENSITY_LOD_PIXELS = 2.0;
+const DENSITY_RES = 256; // texels per side, over the whole world
+const DENSITY_SATURATION = 16; // entities per texel at full intensity
+
+// one column per field, see entity.zig
+const Agent = struct {
+    posX: f32,
+    posY: f32,
+    prevX: f32,
+    prevY: f32,
+    velX: f32,
+    velY: f32,
+    energy: f32,
+    target: u32, // food index picked by the perceive phase, NO_TARGET if none
+    imgID: ImageID,
+    color: u32,
 };
 
-const Input = struct {
-    zoom: f32 = 1.0
+const NO_TARGET = std.math.maxInt(u32);
+
+const AgentStore = entity.Store(Agent);
+
+const Food = struct {
+    posX: f32,
+    posY: f32,
+    energy: f32, // 0 once eaten, removed at the end of the tick
 };
 
+const FoodStore = entity.Store(Food);
+
 const Game = struct {
     input: Input = .{},
+    prev: SimState = .{},
+    cur: SimState = .{},
+    tick: u64 = 0,
+    lastTime: u64 = 0,
+    accumulator: f64 = 0.0,
+    rng: std.rand.DefaultPrng = undefined,
+    foodRng: std.rand.DefaultPrng = undefined,
+    agents: AgentStore = undefined,
+    foods: FoodStore = undefined,
+    foodGrid: grid.Grid = undefined,
+    foodChunks: chunks.ChunkMap = undefined, // chunks with food spawned or eaten
+    foodSpawnBudget: f32 = 0.0,
+    zoomRestores: u32 = 0, // see SpriteBatch.zoomRestores
+    tickDt: f32 = 0.0,
+    tickGraph: jobs.Graph = .{},
+    // simulation temporaries, reset at the start of every tick
+    tickArena: arena.Arena = undefined,
 };
 
 var rdr: Renderer = undefined;
 var game: Game = .{};
 
+// the simulation runs on its own thread in windowed mode, the two threads
+// only talk through these, see handoff.zig
+var simThread: *std.Thread = undefined;
+var simRunning: bool = true;
+var simToRender: handoff.TripleBuffer(SpriteBatch) = undefined;
+var renderToSim: handoff.TripleBuffer(RenderFeedback) = undefined;
+var jobSystem: *jobs.JobSystem = undefined;
+var options: Options = .{};
+var snapSaver: snapshot.Saver = undefined;
+// mapping the restored stores point into, kept until the next restore
+var snapMapping: ?snapshot.Snapshot = null;
+
+// --record and --replay, see replay.zig
+var recorder: ?replay.Recorder = null;
+var player: ?replay.Player = null;
+var replayFrameTimes: Array(u64) = undefined;
+var replayLastTime: u64 = 0;
+
 const state = struct {
     var bind: sg.Bindings = .{};
     var pip: sg.Pipeline = .{};
@@ -90,25 +251,48 @@ const state = struct {
 export fn init() void
 {
     rdr = .{
-        .queueSprite = Array(RenderCommandSprite).init(global_allocator)
+        .frameArenas = arena.FrameArenas.init(global_allocator, FRAME_ARENA_SIZE) catch unreachable,
     };
 
     sg.setup(.{
         .context = sgapp.context()
     });
-    
-     // a vertex buffer
+    stm.setup();
+    prof.setThreadName("main");
+
+    var sdtxDesc: sdtx.Desc = .{};
+    sdtxDesc.fonts[0] = sdtx.fontKc853();
+    sdtx.setup(sdtxDesc);
+
+    simToRender = @TypeOf(simToRender).init(.{
+        SpriteBatch.init(global_allocator),
+        SpriteBatch.init(global_allocator),
+        SpriteBatch.init(global_allocator),
+    });
+    renderToSim = @TypeOf(renderToSim).init(.{ .{}, .{}, .{} });
+    const seed = options.seed orelse stm.now();
+    if(options.record) |path| {
+        recorder = replay.Recorder.create(path, seed) catch |err| {
+            std.debug.panic("failed to create {s}: {s}", .{ path, @errorName(err) });
+        };
+    }
+    replayFrameTimes = Array(u64).init(global_allocator);
+    simThread = std.Thread.spawn(simMain, seed) catch unreachable;
+
+    // unit quad shared by every sprite instance
     const vertices = [_]f32 {
-        // positions         colors
-        -0.5,  0.5, 0.5,     1.0, 0.0, 0.0, 1.0,
-         0.5,  0.5, 0.5,     0.0, 1.0, 0.0, 1.0,
-         0.5, -0.5, 0.5,     0.0, 0.0, 1.0, 1.0,
-        -0.5, -0.5, 0.5,     1.0, 1.0, 0.0, 1.0
+        -0.5,  0.5,
+         0.5,  0.5,
+         0.5, -0.5,
+        -0.5, -0.5,
     };
     state.bind.vertex_buffers[0] = sg.makeBuffer(.{
         .data = sg.asRange(vertices)
     });
 
+    // per instance stream, refilled every frame with sg.appendBuffer
+    reserveSpriteBuffer(4096);
+
     // an index buffer
     const indices = [_] u16 { 0, 1, 2,  0, 2, 3 };
     state.bind.index_buffer = sg.makeBuffer(.{
@@ -119,40 +303,909 @@ export fn init() void
     // a shader and pipeline state object
     var pip_desc: sg.PipelineDesc = .{
         .index_type = .UINT16,
-        .shader = sg.makeShader(shd.colorShaderDesc(sg.queryBackend())),
+        .shader = sg.makeShader(shd.spriteShaderDesc(sg.queryBackend())),
         .depth = .{
             .compare = .LESS_EQUAL,
             .write_enabled = true,
         },
         .cull_mode = .NONE
     };
-    pip_desc.layout.attrs[shd.ATTR_vs_position].format = .FLOAT3;
-    pip_desc.layout.attrs[shd.ATTR_vs_color0].format = .FLOAT4;
+    pip_desc.layout.buffers[1].step_func = .PER_INSTANCE;
+    pip_desc.layout.attrs[shd.ATTR_vs_position] = .{ .format = .FLOAT2, .buffer_index = 0 };
+    pip_desc.layout.attrs[shd.ATTR_vs_inst_pos] = .{ .format = .FLOAT2, .buffer_index = 1 };
+    pip_desc.layout.attrs[shd.ATTR_vs_inst_scale] = .{ .format = .FLOAT2, .buffer_index = 1 };
+    pip_desc.layout.attrs[shd.ATTR_vs_inst_rot] = .{ .format = .FLOAT, .buffer_index = 1 };
+    pip_desc.layout.attrs[shd.ATTR_vs_inst_color] = .{ .format = .UBYTE4N, .buffer_index = 1 };
+    pip_desc.layout.attrs[shd.ATTR_vs_inst_uv] = .{ .format = .USHORT4N, .buffer_index = 1 };
+    pip_desc.colors[0].blend = .{
+        .enabled = true,
+        .src_factor_rgb = .SRC_ALPHA,
+        .dst_factor_rgb = .ONE_MINUS_SRC_ALPHA,
+    };
     state.pip = sg.makePipeline(pip_desc);
 
+    // every image lives in the atlas, bound once for all sprites
+    rdr.atlas = loadAtlas() catch |err| {
+        std.debug.panic("failed to load data/assets.pack: {s} (run 'zig build assets')", .{ @errorName(err) });
+    };
+    state.bind.fs_images[shd.SLOT_tex] = rdr.atlas;
+
+    // density heatmap, one world sized sprite over a streamed texture
+    rdr.densityImage = sg.makeImage(.{
+        .width = DENSITY_RES,
+        .height = DENSITY_RES,
+        .usage = .STREAM,
+        .pixel_format = .RGBA8,
+        .min_filter = .LINEAR,
+        .mag_filter = .LINEAR,
+        .wrap_u = .CLAMP_TO_EDGE,
+        .wrap_v = .CLAMP_TO_EDGE,
+        .label = "density",
+    });
+    const densityQuad = [_]SpriteInstance {
+        .{
+            .pos = .{ 0, 0 },
+            .scale = .{ WORLD_SIZE, WORLD_SIZE },
+            .rot = 0,
+            .color = 0xFFFFFFFF,
+            .uv = .{ 0, 0, 0xFFFF, 0xFFFF },
+        },
+    };
+    rdr.densityQuad = sg.makeBuffer(.{
+        .data = sg.asRange(densityQuad),
+        .label = "density-quad",
+    });
+
     // clear to grey
     state.pass_action.colors[0] = .{ .action=.CLEAR, .value=.{ .r=0.2, .g=0.2, .b=0.2, .a=1 } };
+}
+
+// everything the simulation needs, shared by the windowed and headless modes
+fn initSim(seed: u64) void
+{
+    jobSystem = jobs.JobSystem.init(global_allocator, 0) catch unreachable;
+    buildTickGraph(&game);
+    game.tickArena = arena.Arena.init(global_allocator, TICK_ARENA_SIZE) catch unreachable;
+
+    game.rng = std.rand.DefaultPrng.init(seed);
+    game.foodRng = std.rand.DefaultPrng.init(seed +% 1);
+    game.agents = AgentStore.init(global_allocator);
+    game.foods = FoodStore.init(global_allocator);
+    game.foodGrid = grid.Grid.init(global_allocator, FOOD_GRID_CELL_SIZE);
+    game.foodChunks = chunks.ChunkMap.init(global_allocator, WORLD_SIZE, FOOD_CHUNK_SIZE) catch unreachable;
+    spawnAgents(AGENT_START_COUNT);
+    spawnFood(FOOD_START_COUNT);
+    phaseFoodGrid(&game);
+    snapSaver = snapshot.Saver.init(global_allocator);
+}
+
+//
+// snapshots, see snapshot.zig
+// the food grid and the task graph are derived and rebuilt after a restore
+//
+const SNAPSHOT_PATH = "life.snap";
+
+// the rest of the world state, stored in the snapshot meta block
+const WorldMeta = extern struct {
+    tick: u64,
+    rng: [4]u64,
+    foodRng: [4]u64,
+    foodSpawnBudget: f32,
+    camZoom: f32,
+};
+
+// only the column copy happens here, the file is written in the background
+fn saveWorld(path: []const u8) !void
+{
+    const meta = WorldMeta {
+        .tick = game.tick,
+        .rng = game.rng.s,
+        .foodRng = game.foodRng.s,
+        .foodSpawnBudget = game.foodSpawnBudget,
+        .camZoom = game.cur.camZoom,
+    };
+    try snapSaver.save(path, &meta, .{ &game.agents, &game.foods });
+}
+
+// the stores keep using the mapped columns until they grow
+fn loadWorld(path: []const u8) !void
+{
+    var snap = try snapshot.Snapshot.open(global_allocator, path);
+    errdefer snap.close();
+    const meta = try snap.meta(WorldMeta);
+    var agents = try snap.store(AgentStore, global_allocator, 0);
+    errdefer agents.deinit();
+    var foods = try snap.store(FoodStore, global_allocator, 1);
+    errdefer foods.deinit();
+
+    game.agents.deinit();
+    game.foods.deinit();
+    if(snapMapping) |*previous| previous.close();
+    game.agents = agents;
+    game.foods = foods;
+    snapMapping = snap;
+
+    game.tick = meta.tick;
+    game.rng.s = meta.rng;
+    game.foodRng.s = meta.foodRng;
+    game.foodSpawnBudget = meta.foodSpawnBudget;
+    game.cur.camZoom = meta.camZoom;
+    game.prev = game.cur;
+    game.input.zoom = meta.camZoom;
+    game.zoomRestores +%= 1;
+    game.foodChunks.markAll();
+    phaseFoodGrid(&game);
+}
+
+// the pack is mapped, not read: the mip levels are handed to sokol in place
+fn loadAtlas() !sg.Image
+{
+    var assetPack = try pack.Pack.open(global_allocator, "data/assets.pack");
+    defer assetPack.close();
+
+    const images = assetPack.images();
+    if(images.len < 1) return error.AtlasMissing;
+    const rec = images[0];
+    if(rec.width != atlas.width or rec.height != atlas.height) return error.AtlasSizeMismatch;
+
+    var desc: sg.ImageDesc = .{
+        .width = atlas.width,
+        .height = atlas.height,
+        .num_mipmaps = @intCast(i32, rec.mip_count),
+        .pixel_format = .RGBA8,
+        .min_filter = .LINEAR_MIPMAP_LINEAR,
+        .mag_filter = .LINEAR,
+        .wrap_u = .CLAMP_TO_EDGE,
+        .wrap_v = .CLAMP_TO_EDGE,
+        .label = "atlas",
+    };
+    var level: usize = 0;
+    while(level < rec.mip_count) {
+        desc.data.subimage[0][level] = sg.asRange(assetPack.mipData(rec, level));
+        level += 1;
+    }
+    return sg.makeImage(desc);
+}
+
+// (re)create the instance buffer so it can hold at least count sprites
+fn reserveSpriteBuffer(count: usize) void
+{
+    if(count <= rdr.spriteBufferCapacity) return;
+
+    var capacity = std.math.max(rdr.spriteBufferCapacity, 1024);
+    while(capacity < count) {
+        capacity *= 2;
+    }
+
+    if(rdr.spriteBuffer.id != sg.invalid_id) {
+        sg.destroyBuffer(rdr.spriteBuffer);
+    }
+    rdr.spriteBuffer = sg.makeBuffer(.{
+        .size = capacity * @sizeOf(SpriteInstance),
+        .usage = .STREAM,
+        .label = "sprite-instances",
+    });
+    rdr.spriteBufferCapacity = capacity;
+    state.bind.vertex_buffers[1] = rdr.spriteBuffer;
+}
+
+// pack the whole sprite queue into the instance stream and draw it with a
+// single instanced draw, then empty the queue for the next frame
+fn drawSpriteQueue() void
+{
+    const zone = prof.begin("drawSpriteQueue");
+    defer zone.end();
+
+    const queue = rdr.queueSprite.items;
+    if(queue.len == 0) return;
+
+    // must happen before the first append of the frame
+    reserveSpriteBuffer(queue.len);
+
+    const instances = rdr.frameAllocator.alloc(SpriteInstance, queue.len) catch unreachable;
+    sprite.packInstances(queue, instances);
+
+    // all images share the atlas, so texture changes never split the batch
+    var bind = state.bind;
+    bind.vertex_buffer_offsets[1] = sg.appendBuffer(rdr.spriteBuffer, sg.asRange(instances));
+    sg.applyBindings(bind);
+    sg.draw(0, 6, @intCast(u32, queue.len));
+}
+
+// rebake the food chunks the batch carries, immutable buffers are replaced
+// rather than updated; the renderer only uploads food that changed
+fn bakeFoodChunks(batch: *const SpriteBatch) void
+{
+    const zone = prof.begin("bakeFoodChunks");
+    defer zone.end();
+
+    for(batch.chunkUpdates.items) |update| {
+        const chunk = &rdr.foodChunks[update.chunk];
+        if(chunk.version == update.version) continue;
+
+        if(chunk.buffer.id != sg.invalid_id) {
+            sg.destroyBuffer(chunk.buffer);
+        }
+        chunk.* = .{ .version = update.version, .count = update.count, .bounds = update.bounds };
+        if(update.count > 0) {
+            chunk.buffer = sg.makeBuffer(.{
+                .data = sg.asRange(batch.chunkSprites.items[update.first..][0..update.count]),
+                .label = "food-chunk",
+            });
+        }
+    }
+    rdr.feedback.chunkSeq = batch.seq;
+}
+
+// the texture only changes with a new batch
+fn uploadDensity(batch: *const SpriteBatch) void
+{
+    if(batch.seq == rdr.densitySeq) return;
+    rdr.densitySeq = batch.seq;
+
+    var data: sg.ImageData = .{};
+    data.subimage[0][0] = sg.asRange(batch.density.items);
+    sg.updateImage(rdr.densityImage, data);
+}
+
+fn drawDensity() void
+{
+    var bind = state.bind;
+    bind.vertex_buffers[1] = rdr.densityQuad;
+    bind.vertex_buffer_offsets[1] = 0;
+    bind.fs_images[shd.SLOT_tex] = rdr.densityImage;
+    sg.applyBindings(bind);
+    sg.draw(0, 6, 1);
+}
+
+// one instanced draw per visible chunk, straight from its cached buffer
+fn drawFoodChunks(view: kernels.Rect) void
+{
+    const zone = prof.begin("drawFoodChunks");
+    defer zone.end();
+
+    var bind = state.bind;
+    for(rdr.foodChunks) |chunk| {
+        if(chunk.count == 0) continue;
+        const b = chunk.bounds;
+        if(b.maxX < view.minX or b.minX > view.maxX or b.maxY < view.minY or b.minY > view.maxY) continue;
 
-    rdr.queueSprite.append(.{
-        .pos = .{ .x = 0.0, .y =  0.0 },
-        .imgID = comptime ImageID.fromPath("data/bouffe.png"),
+        bind.vertex_buffers[1] = chunk.buffer;
+        bind.vertex_buffer_offsets[1] = 0;
+        sg.applyBindings(bind);
+        sg.draw(0, 6, chunk.count);
+    }
+}
+
+fn spawnAgent(random: *std.rand.Random, x: f32, y: f32, energy: f32) void
+{
+    const angle = random.float(f32) * std.math.pi * 2.0;
+    _ = game.agents.create(.{
+        .posX = x,
+        .posY = y,
+        .prevX = x,
+        .prevY = y,
+        .velX = std.math.cos(angle) * AGENT_SPEED,
+        .velY = std.math.sin(angle) * AGENT_SPEED,
+        .energy = energy,
+        .target = NO_TARGET,
+        .imgID = .{ .u = 0 },
+        .color = 0xFF000000 | (random.int(u32) & 0x00FFFFFF),
     }) catch unreachable;
 }
 
-export fn frame() void
+fn spawnAgents(count: u32) void
+{
+    var random = &game.rng.random;
+    game.agents.ensureCapacity(game.agents.len + count) catch unreachable;
+
+    var i: u32 = 0;
+    while(i < count) {
+        const x = (random.float(f32) - 0.5) * WORLD_SIZE;
+        const y = (random.float(f32) - 0.5) * WORLD_SIZE;
+        spawnAgent(random, x, y, 30.0 + random.float(f32) * 90.0);
+        i += 1;
+    }
+}
+
+fn spawnFood(count: u32) void
+{
+    // own generator, food spawning runs concurrently with reproduction
+    var random = &game.foodRng.random;
+    var i: u32 = 0;
+    while(i < count) {
+        const x = (random.float(f32) - 0.5) * WORLD_SIZE;
+        const y = (random.float(f32) - 0.5) * WORLD_SIZE;
+        _ = game.foods.create(.{
+            .posX = x,
+            .posY = y,
+            .energy = FOOD_ENERGY,
+        }) catch unreachable;
+        game.foodChunks.markDirty(x, y);
+        i += 1;
+    }
+}
+
+const UneatenFood = struct {
+    energy: []const f32,
+
+    pub fn accept(self: UneatenFood, index: u32) bool {
+        return self.energy[index] > 0.0;
+    }
+};
+
+//
+// simulation tick, one task per phase, see buildTickGraph()
+// parallel phases only write the columns of their own agent range
+//
+const AGENT_GRAIN = 1024;
+
+// runs last so the grid matches the food store between ticks, both the next
+// perceive phase and the renderer query it
+fn phaseFoodGrid(g: *Game) void
+{
+    g.foodGrid.build(g.foods.items(.posX), g.foods.items(.posY), &g.tickArena.allocator) catch unreachable;
+}
+
+// closest uneaten food in sight, the grid keeps this O(agents) instead of
+// O(agents * food)
+fn perceiveRange(g: *Game, begin: usize, end: usize) void
+{
+    const filter = UneatenFood{ .energy = g.foods.items(.energy) };
+    const posX = g.agents.items(.posX);
+    const posY = g.agents.items(.posY);
+    const target = g.agents.items(.target);
+    var i = begin;
+    while(i < end) {
+        target[i] = g.foodGrid.nearest(posX[i], posY[i], AGENT_SIGHT, filter) orelse NO_TARGET;
+        i += 1;
+    }
+}
+
+fn phasePerceive(g: *Game) void
+{
+    jobSystem.parallelFor(g.agents.len, AGENT_GRAIN, g, perceiveRange);
+}
+
+// steer towards the target food, keep going straight otherwise
+fn decideRange(g: *Game, begin: usize, end: usize) void
+{
+    const foodX = g.foods.items(.posX);
+    const foodY = g.foods.items(.posY);
+    const posX = g.agents.items(.posX);
+    const posY = g.agents.items(.posY);
+    const velX = g.agents.items(.velX);
+    const velY = g.agents.items(.velY);
+    const target = g.agents.items(.target);
+    var i = begin;
+    while(i < end) {
+        if(target[i] != NO_TARGET) {
+            const dx = foodX[target[i]] - posX[i];
+            const dy = foodY[target[i]] - posY[i];
+            const dist = std.math.sqrt(dx * dx + dy * dy);
+            if(dist > AGENT_EAT_RADIUS) {
+                velX[i] = dx / dist * AGENT_SPEED;
+                velY[i] = dy / dist * AGENT_SPEED;
+            }
+        }
+        i += 1;
+    }
+}
+
+fn phaseDecide(g: *Game) void
+{
+    jobSystem.parallelFor(g.agents.len, AGENT_GRAIN, g, decideRange);
+}
+
+fn moveRange(g: *Game, begin: usize, end: usize) void
+{
+    const columns = kernels.MoveColumns {
+        .posX = g.agents.items(.posX)[begin..end],
+        .posY = g.agents.items(.posY)[begin..end],
+        .prevX = g.agents.items(.prevX)[begin..end],
+        .prevY = g.agents.items(.prevY)[begin..end],
+        .velX = g.agents.items(.velX)[begin..end],
+        .velY = g.agents.items(.velY)[begin..end],
+    };
+    kernels.moveSimd(kernels.lanes, columns, .{ .dt = g.tickDt, .worldHalf = WORLD_HALF });
+}
+
+fn phaseMove(g: *Game) void
+{
+    jobSystem.parallelFor(g.agents.len, AGENT_GRAIN, g, moveRange);
+}
+
+// only touches the energy column, runs next to perceive/decide/move
+fn decayRange(g: *Game, begin: usize, end: usize) void
+{
+    kernels.decaySimd(kernels.lanes, g.agents.items(.energy)[begin..end], AGENT_ENERGY_DECAY * g.tickDt);
+}
+
+fn phaseDecay(g: *Game) void
+{
+    jobSystem.parallelFor(g.agents.len, AGENT_GRAIN, g, decayRange);
+}
+
+// serial: two agents may reach the same food, first in agent order wins
+fn phaseEat(g: *Game) void
+{
+    const foodX = g.foods.items(.posX);
+    const foodY = g.foods.items(.posY);
+    const foodEnergy = g.foods.items(.energy);
+    const posX = g.agents.items(.posX);
+    const posY = g.agents.items(.posY);
+    const energy = g.agents.items(.energy);
+    for(g.agents.items(.target)) |t, i| {
+        if(t == NO_TARGET or foodEnergy[t] <= 0.0) continue;
+        const dx = foodX[t] - posX[i];
+        const dy = foodY[t] - posY[i];
+        if(dx * dx + dy * dy <= AGENT_EAT_RADIUS * AGENT_EAT_RADIUS) {
+            energy[i] += foodEnergy[t];
+            foodEnergy[t] = 0.0;
+        }
+    }
+}
+
+// serial: removes starved agents and splits the well fed ones
+fn phaseReproduce(g: *Game) void
+{
+    const agents = &g.agents;
+
+    // backwards, swap-remove only moves already visited agents
+    var i = agents.len;
+    while(i > 0) {
+        i -= 1;
+        if(agents.items(.energy)[i] <= 0.0) {
+            agents.removeAt(i);
+        }
+    }
+
+    const count = agents.len;
+    i = 0;
+    while(i < count) {
+        const energy = &agents.items(.energy)[i];
+        if(energy.* >= AGENT_REPRODUCE_ENERGY) {
+            energy.* /= 2.0;
+            spawnAgent(&g.rng.random, agents.items(.posX)[i], agents.items(.posY)[i], energy.*);
+        }
+        i += 1;
+    }
+}
+
+// serial: compacts eaten food and grows new food
+fn phaseFood(g: *Game) void
+{
+    const foods = &g.foods;
+    const energy = foods.items(.energy);
+    const posX = foods.items(.posX);
+    const posY = foods.items(.posY);
+    var i = foods.len;
+    while(i > 0) {
+        i -= 1;
+        if(energy[i] <= 0.0) {
+            g.foodChunks.markDirty(posX[i], posY[i]);
+            foods.removeAt(i);
+        }
+    }
+
+    g.foodSpawnBudget += FOOD_SPAWN_RATE * g.tickDt;
+    const spawn = @floatToInt(u32, g.foodSpawnBudget);
+    g.foodSpawnBudget -= @intToFloat(f32, spawn);
+    spawnFood(spawn);
+}
+
+//  perceive -> decide -> move --+-> eat -+-> reproduce
+//  decay -----------------------+        +-> food -> foodGrid
+fn buildTickGraph(g: *Game) void
+{
+    var graph = &g.tickGraph;
+    graph.* = .{};
+    const perceive = graph.add("perceive", g, phasePerceive, &.{});
+    const decide = graph.add("decide", g, phaseDecide, &.{ perceive });
+    const move = graph.add("move", g, phaseMove, &.{ decide });
+    const decay = graph.add("decay", g, phaseDecay, &.{});
+    const eat = graph.add("eat", g, phaseEat, &.{ move, decay });
+    _ = graph.add("reproduce", g, phaseReproduce, &.{ eat });
+    const food = graph.add("food", g, phaseFood, &.{ eat });
+    _ = graph.add("foodGrid", g, phaseFoodGrid, &.{ food });
+}
+
+fn simTick(dt: f32) void
 {
-    // zoom over many frames (smooth zoom)
-    // TODO: make this better
-    if(rdr.cam.zoom != game.input.zoom) {
-        const delta = game.input.zoom - rdr.cam.zoom;
+    const zone = prof.begin("simTick");
+    defer zone.end();
+
+    game.prev = game.cur;
+    var cur = &game.cur;
+
+    // smooth zoom, closes 10% of the gap every 1/60s whatever the tick rate
+    if(cur.camZoom != game.input.zoom) {
+        const delta = game.input.zoom - cur.camZoom;
         if(std.math.fabs(delta) < 0.000001) {
-            rdr.cam.zoom = game.input.zoom;
+            cur.camZoom = game.input.zoom;
         }
         else {
-            rdr.cam.zoom += delta / 10.0;
+            cur.camZoom += delta * (1.0 - std.math.pow(f32, 0.9, dt * 60.0));
+        }
+    }
+
+    game.tickDt = dt;
+    game.tickArena.reset();
+    game.tickGraph.run(jobSystem);
+
+    game.tick += 1;
+}
+
+// run as many fixed ticks as the elapsed time asks for, returns how many ran
+fn simAdvance() u32
+{
+    game.accumulator += stm.sec(stm.laptime(&game.lastTime));
+
+    var ticks: u32 = 0;
+    while(game.accumulator >= SIM_DT and ticks < SIM_MAX_CATCHUP_TICKS) {
+        simTick(SIM_DT);
+        game.accumulator -= SIM_DT;
+        ticks += 1;
+    }
+
+    if(game.accumulator >= SIM_DT) {
+        game.accumulator = 0.0;
+    }
+
+    return ticks;
+}
+
+fn simMain(seed: u64) void
+{
+    prof.setThreadName("sim");
+    initSim(seed);
+    if(options.load) |path| {
+        loadWorld(path) catch |err| {
+            std.debug.panic("failed to load {s}: {s}", .{ path, @errorName(err) });
+        };
+    }
+
+    var handled = RenderFeedback{};
+    publishBatch(handled);
+    while(@atomicLoad(bool, &simRunning, .Acquire)) {
+        const feedback = renderToSim.latest().*;
+        // only a zoom the renderer changed, a restored one stands until the
+        // renderer has adopted it
+        if(feedback.zoom != handled.zoom) {
+            handled.zoom = feedback.zoom;
+            game.input.zoom = feedback.zoom;
+        }
+
+        var changed = false;
+        if(feedback.saveRequests != handled.saveRequests) {
+            handled.saveRequests = feedback.saveRequests;
+            saveWorld(SNAPSHOT_PATH) catch |err| {
+                std.debug.print("snapshot save failed: {s}\n", .{ @errorName(err) });
+            };
+        }
+        if(feedback.loadRequests != handled.loadRequests) {
+            handled.loadRequests = feedback.loadRequests;
+            loadWorld(SNAPSHOT_PATH) catch |err| {
+                std.debug.print("snapshot load failed: {s}\n", .{ @errorName(err) });
+            };
+            changed = true;
+        }
+
+        if(simAdvance() > 0 or changed) {
+            publishBatch(feedback);
+        }
+
+        // nothing to do until the next tick is due
+        const wait = SIM_DT - game.accumulator;
+        if(wait > 0.0) {
+            std.time.sleep(@floatToInt(u64, wait * std.time.ns_per_s));
+        }
+    }
+
+    snapSaver.deinit();
+    jobSystem.deinit();
+}
+
+fn lerp(a: f32, b: f32, t: f32) f32
+{
+    return a + (b - a) * t;
+}
+
+const FOOD_SPRITE_SIZE = 16.0;
+const AGENT_SPRITE_SIZE = 8.0;
+
+// sprites are culled by their center, the view is grown by this factor of
+// the sprite size so rotated sprites straddling the edge still get drawn
+const CULL_MARGIN = 0.75;
+
+fn growRect(r: kernels.Rect, margin: f32) kernels.Rect
+{
+    return .{
+        .minX = r.minX - margin,
+        .minY = r.minY - margin,
+        .maxX = r.maxX + margin,
+        .maxY = r.maxY + margin,
+    };
+}
+
+// food only changes where it is spawned or eaten: every chunk changed since
+// the last batch the renderer baked from goes out whole, wherever the view is
+fn batchFoodChunks(batch: *SpriteBatch, seen: u64) void
+{
+    const Visitor = struct {
+        batch: *SpriteBatch,
+        chunk: u32,
+        posX: []const f32,
+        posY: []const f32,
+
+        fn visit(self: *@This(), index: u32) void
+        {
+            const x = self.posX[index];
+            const y = self.posY[index];
+            // chunk rects share their edges
+            if(game.foodChunks.chunkOf(x, y) != self.chunk) return;
+            self.batch.chunkSprites.append(sprite.instance(.{
+                .pos = vec2.new(x, y),
+                .scale = vec2.new(FOOD_SPRITE_SIZE, FOOD_SPRITE_SIZE),
+                .imgID = comptime ImageID.fromPath("data/bouffe.png"),
+            })) catch unreachable;
+        }
+    };
+
+    batch.seq = game.foodChunks.publish();
+    var chunk: u32 = 0;
+    while(chunk < game.foodChunks.count()) {
+        defer chunk += 1;
+        if(!game.foodChunks.changedSince(chunk, seen)) continue;
+
+        const first = batch.chunkSprites.items.len;
+        var visitor = Visitor {
+            .batch = batch,
+            .chunk = chunk,
+            .posX = game.foods.items(.posX),
+            .posY = game.foods.items(.posY),
+        };
+        const r = game.foodChunks.rect(chunk);
+        game.foodGrid.forEachInRect(r.minX, r.minY, r.maxX, r.maxY, &visitor);
+        batch.chunkUpdates.append(.{
+            .chunk = chunk,
+            .version = game.foodChunks.changedAt[chunk],
+            .bounds = growRect(r, FOOD_SPRITE_SIZE * CULL_MARGIN),
+            .first = @intCast(u32, first),
+            .count = @intCast(u32, batch.chunkSprites.items.len - first),
+        }) catch unreachable;
+    }
+}
+
+// agents have no grid of their own, they go through a SIMD bounds test;
+// the margin covers a tick of movement so the previous position is in too
+fn batchAgents(batch: *SpriteBatch, view: kernels.Rect) void
+{
+    const agents = &game.agents;
+    const posX = agents.items(.posX);
+    const posY = agents.items(.posY);
+    const prevX = agents.items(.prevX);
+    const prevY = agents.items(.prevY);
+    const imgID = agents.items(.imgID);
+    const color = agents.items(.color);
+
+    const visibleIndices = game.tickArena.allocator.alloc(u32, agents.len) catch unreachable;
+    const columns = kernels.CullColumns {
+        .posX = posX,
+        .posY = posY,
+        .prevX = prevX,
+        .prevY = prevY,
+    };
+    const r = growRect(view, AGENT_SPRITE_SIZE * CULL_MARGIN + AGENT_SPEED * SIM_DT);
+    const visible = visibleIndices[0..kernels.cullSimd(kernels.lanes, columns, 1.0, r, visibleIndices)];
+
+    batch.sprites.ensureCapacity(batch.sprites.items.len + visible.len) catch unreachable;
+    batch.prevPos.ensureCapacity(batch.prevPos.items.len + visible.len) catch unreachable;
+    for(visible) |i| {
+        batch.sprites.appendAssumeCapacity(.{
+            .pos = vec2.new(posX[i], posY[i]),
+            .scale = vec2.new(AGENT_SPRITE_SIZE, AGENT_SPRITE_SIZE),
+            .color = color[i],
+            .imgID = imgID[i],
+        });
+        batch.prevPos.appendAssumeCapacity(vec2.new(prevX[i], prevY[i]));
+    }
+}
+
+// intensity per entity count, square root so sparse areas still show
+const densityLevels = blk: {
+    var levels: [DENSITY_SATURATION + 1]u8 = undefined;
+    for(levels) |*level, i| {
+        level.* = @floatToInt(u8, @sqrt(@intToFloat(f32, i) / DENSITY_SATURATION) * 255.0);
+    }
+    break :blk levels;
+};
+
+fn densityLevel(count: u32) u32
+{
+    return densityLevels[std.math.min(count, DENSITY_SATURATION)];
+}
+
+// zoomed out: agents and food binned over the whole world, agents in red and
+// food in green; the cost doesn't depend on the view and the renderer's
+// doesn't depend on the population
+fn batchDensity(batch: *SpriteBatch) void
+{
+    const zone = prof.begin("batchDensity");
+    defer zone.end();
+
+    const allocator = &game.tickArena.allocator;
+    const agentCount = allocator.alloc(u32, DENSITY_RES * DENSITY_RES) catch unreachable;
+    const foodCount = allocator.alloc(u32, DENSITY_RES * DENSITY_RES) catch unreachable;
+    std.mem.set(u32, agentCount, 0);
+    std.mem.set(u32, foodCount, 0);
+    kernels.binDensity(game.agents.items(.posX), game.agents.items(.posY), WORLD_HALF, DENSITY_RES, agentCount);
+    kernels.binDensity(game.foods.items(.posX), game.foods.items(.posY), WORLD_HALF, DENSITY_RES, foodCount);
+
+    batch.density.resize(DENSITY_RES * DENSITY_RES) catch unreachable;
+    for(batch.density.items) |*texel, i| {
+        const r = densityLevel(agentCount[i]);
+        const g = densityLevel(foodCount[i]);
+        texel.* = (std.math.max(r, g) << 24) | (g << 8) | r; // 0xAABBGGRR
+    }
+}
+
+// sim thread: culled against the view of the last rendered frame
+fn publishBatch(feedback: RenderFeedback) void
+{
+    const zone = prof.begin("publishBatch");
+    defer zone.end();
+
+    const batch = simToRender.writeBuffer();
+    batch.clear();
+    batchFoodChunks(batch, feedback.chunkSeq);
+    batch.densityLod = AGENT_SPRITE_SIZE * game.cur.camZoom < DENSITY_LOD_PIXELS;
+    if(batch.densityLod) {
+        batchDensity(batch);
+    }
+    else {
+        batchAgents(batch, feedback.view);
+    }
+    batch.prevZoom = game.prev.camZoom;
+    batch.curZoom = game.cur.camZoom;
+    batch.zoomRestores = game.zoomRestores;
+    batch.inputZoom = game.input.zoom;
+    batch.time = stm.now();
+    simToRender.publish();
+}
+
+// render thread: interpolated copies of the batch sprites
+fn queueBatch(batch: *const SpriteBatch, alpha: f32) void
+{
+    const zone = prof.begin("queueBatch");
+    defer zone.end();
+
+    rdr.queueSprite.ensureCapacity(rdr.queueSprite.items.len + batch.sprites.items.len) catch unreachable;
+    for(batch.sprites.items) |item, i| {
+        var cmd = item;
+        const prev = batch.prevPos.items[i];
+        cmd.pos = vec2.new(lerp(prev.x, item.pos.x, alpha), lerp(prev.y, item.pos.y, alpha));
+        rdr.queueSprite.appendAssumeCapacity(cmd);
+    }
+}
+
+const PROF_OVERLAY_INTERVAL = 1.0; // seconds
+const PROF_TRACE_PATH = "life_trace.json";
+
+// per thread zone summary over the last interval, a bar shows the share of
+// the interval spent in the zone
+fn drawProfilerOverlay() void
+{
+    const zone = prof.begin("profilerOverlay");
+    defer zone.end();
+
+    const elapsed = stm.sec(stm.since(rdr.profWindowStart));
+    if(elapsed >= PROF_OVERLAY_INTERVAL) {
+        const stats = prof.summarize(global_allocator, rdr.profWindowStart) catch return;
+        global_allocator.free(rdr.profStats);
+        rdr.profStats = stats;
+        rdr.profWindowStart = stm.now();
+        rdr.profWindowSec = elapsed;
+    }
+
+    sdtx.canvas(sapp.widthf() * 0.5, sapp.heightf() * 0.5);
+    sdtx.origin(1.0, 1.0);
+    sdtx.color3b(255, 255, 255);
+    sdtx.print("{s:<26}{s:>8}{s:>9}{s:>9}\n", .{ "zone", "calls/s", "ms/s", "max ms" });
+
+    var thread: u32 = std.math.maxInt(u32);
+    for(rdr.profStats) |stat| {
+        if(stat.thread != thread) {
+            thread = stat.thread;
+            sdtx.color3b(255, 200, 80);
+            sdtx.print("{s}\n", .{ prof.threadName(thread) });
+            sdtx.color3b(255, 255, 255);
+        }
+
+        // indent and name fill the 26 columns of the header's "zone", deeper
+        // zones leave less room to the name
+        const indent = std.math.min(stat.depth, 24) + 1;
+        const name = stat.name[0..std.math.min(stat.name.len, 26 - indent)];
+        var col: usize = 0;
+        while(col < indent) {
+            sdtx.putc(' ');
+            col += 1;
+        }
+        sdtx.print("{s}", .{ name });
+        col += name.len;
+        while(col < 26) {
+            sdtx.putc(' ');
+            col += 1;
+        }
+        const ms = stm.ms(stat.total) / rdr.profWindowSec;
+        sdtx.print("{d:>8.0}{d:>9.2}{d:>9.2} ", .{
+            @intToFloat(f64, stat.calls) / rdr.profWindowSec,
+            ms, stm.ms(stat.max)
+        });
+        const bar = @floatToInt(u32, std.math.min(ms / 1000.0, 1.0) * 20.0);
+        col = 0;
+        while(col < bar) {
+            sdtx.putc('#');
+            col += 1;
         }
+        sdtx.crlf();
     }
 
+    // pools growing past startup means the initial sg.Desc sizes are too small
+    const pools = sg.queryPoolStats();
+    sdtx.color3b(255, 200, 80);
+    sdtx.print("sokol pools (used/capacity, grows)\n", .{});
+    sdtx.color3b(255, 255, 255);
+    sdtx.print(" buffers {d}/{d} {d}  images {d}/{d} {d}\n", .{
+        pools.buffers.num_used, pools.buffers.capacity, pools.buffers.grow_count,
+        pools.images.num_used, pools.images.capacity, pools.images.grow_count
+    });
+
+    // last frame: call count, state churn and upload bandwidth
+    const fs = sg.queryFrameStats();
+    sdtx.color3b(255, 200, 80);
+    sdtx.print("sokol frame {d}\n", .{ fs.frame_index });
+    sdtx.color3b(255, 255, 255);
+    sdtx.print(" draws {d}  instances {d}  vertices {d}\n", .{ fs.num_draw, fs.num_instances, fs.num_vertices });
+    sdtx.print(" pipelines {d}  bindings {d}  uniforms {d} ({d} ubo)\n", .{
+        fs.num_apply_pipeline, fs.num_apply_bindings, fs.num_apply_uniforms, fs.gl.num_bind_uniform_buffer
+    });
+    sdtx.print(" gl binds {d} (+{d} cached)  attribs {d} (+{d} cached)\n", .{
+        fs.gl.num_bind_buffer + fs.gl.num_bind_texture,
+        fs.gl.num_redundant_bind_buffer + fs.gl.num_redundant_bind_texture,
+        fs.gl.num_vertex_attrib_pointer, fs.gl.num_redundant_vertex_attrib
+    });
+    sdtx.print(" gl vaos {d} ({d} built)\n", .{
+        fs.gl.num_bind_vertex_array, fs.gl.num_vertex_array_cache_miss
+    });
+    sdtx.print(" upload KB  buffers {d:.1}  images {d:.1}  uniforms {d:.1}\n", .{
+        @intToFloat(f32, fs.size_update_buffer + fs.size_append_buffer) / 1024.0,
+        @intToFloat(f32, fs.size_update_image) / 1024.0,
+        @intToFloat(f32, fs.size_apply_uniforms) / 1024.0
+    });
+    sdtx.draw();
+}
+
+export fn frame() void
+{
+    const frameZone = prof.begin("frame");
+    defer frameZone.end();
+    defer rdr.frameIndex += 1;
+
+    if(player) |*p| {
+        replayFrame(p);
+    }
+
+    // the batch shows the step from the previous to the current tick, spread
+    // over the tick that follows its publication
+    const batch = simToRender.latest();
+    if(batch.zoomRestores != rdr.zoomRestores) {
+        rdr.zoomRestores = batch.zoomRestores;
+        rdr.feedback.zoom = batch.inputZoom;
+    }
+    const alpha = @floatCast(f32, std.math.min(stm.sec(stm.since(batch.time)) / SIM_DT, 1.0));
+    rdr.cam.zoom = lerp(batch.prevZoom, batch.curZoom, alpha);
+
     const hw = sapp.widthf() / 2.0;
     const hh = sapp.heightf() / 2.0;
 
@@ -165,44 +1218,317 @@ export fn frame() void
         mat4.ortho(left, right, bottom, top, -10.0, 10.0)
     };
 
+    // y grows downwards, top is the smaller coordinate
+    const view = kernels.Rect { .minX = left, .minY = top, .maxX = right, .maxY = bottom };
+    bakeFoodChunks(batch);
+    if(batch.densityLod) {
+        uploadDensity(batch);
+    }
+    rdr.feedback.view = view;
+    renderToSim.writeBuffer().* = rdr.feedback;
+    renderToSim.publish();
+
+    // reserved once, the queue is a single bump
+    rdr.frameAllocator = rdr.frameArenas.flip();
+    rdr.queueSprite = Array(RenderCommandSprite).init(rdr.frameAllocator);
+    queueBatch(batch, alpha);
+
     sg.beginDefaultPass(state.pass_action, sapp.width(), sapp.height());
     sg.applyPipeline(state.pip);
-    sg.applyBindings(state.bind);
     sg.applyUniforms(.VS, shd.SLOT_vs_params, sg.asRange(vs_params));
-    sg.draw(0, 6, 1);
+    if(batch.densityLod) {
+        drawDensity(); // the agents aren't in the batch
+    }
+    else {
+        drawFoodChunks(view); // under the agents
+    }
+    drawSpriteQueue();
+    if(rdr.showProfiler) {
+        drawProfilerOverlay();
+    }
     sg.endPass();
     sg.commit();
 }
 
 export fn cleanup() void
 {
+    @atomicStore(bool, &simRunning, false, .Release);
+    simThread.wait();
+
+    if(recorder) |*r| {
+        r.close() catch |err| {
+            std.debug.print("recording failed: {s}\n", .{ @errorName(err) });
+        };
+        recorder = null;
+    }
+
+    std.debug.print("frame arena high water: {d} bytes, tick arena: {d} bytes\n", .{
+        rdr.frameArenas.highWater(), game.tickArena.highWater
+    });
+    sdtx.shutdown();
     sg.shutdown();
 }
 
 export fn input(ev: ?*const sapp.Event) void
 {
-    const event = ev.?;
+    // a replay owns the input, live events would make it diverge
+    if(player != null) return;
+    if(recorder) |*r| {
+        r.record(rdr.frameIndex, ev.?) catch |err| {
+            std.debug.print("recording failed: {s}\n", .{ @errorName(err) });
+            recorder = null;
+        };
+    }
+    handleEvent(ev.?);
+}
+
+// live and replayed events both end up here
+fn handleEvent(event: *const sapp.Event) void
+{
     if(event.type == .KEY_DOWN) {
         if(event.key_code == .ESCAPE) {
             sapp.quit();
         }
         if(event.key_code == .F1) {
             //reset Camera
-            game.input.zoom = 1.0;
+            rdr.feedback.zoom = 1.0;
+        }
+        if(event.key_code == .F2) {
+            rdr.showProfiler = !rdr.showProfiler;
+            rdr.profWindowStart = stm.now();
+        }
+        if(event.key_code == .F3) {
+            prof.writeChromeTrace(global_allocator, PROF_TRACE_PATH) catch |err| {
+                std.debug.print("trace export failed: {s}\n", .{ @errorName(err) });
+            };
+        }
+        // handled by the sim thread between two ticks
+        if(event.key_code == .F5) {
+            rdr.feedback.saveRequests +%= 1;
+        }
+        if(event.key_code == .F9) {
+            rdr.feedback.loadRequests +%= 1;
         }
     }
     else if(event.type == .MOUSE_SCROLL) {
         if(event.scroll_y > 0.0) {
-            game.input.zoom *= 1.0 + event.scroll_y * 0.1;
+            rdr.feedback.zoom *= 1.0 + event.scroll_y * 0.1;
         }
         else {
-            game.input.zoom /= 1.0 + -event.scroll_y * 0.1;
+            rdr.feedback.zoom /= 1.0 + -event.scroll_y * 0.1;
         }
     }
 }
 
+// feeds the events recorded for this frame through handleEvent and times
+// every frame; once the recording is exhausted it prints the frame times
+// and quits, so a recorded session doubles as a performance test
+fn replayFrame(p: *replay.Player) void
+{
+    const dt = stm.laptime(&replayLastTime);
+    if(rdr.frameIndex > 0) {
+        replayFrameTimes.append(dt) catch {};
+    }
+
+    while(p.poll(rdr.frameIndex)) |event| {
+        handleEvent(&event);
+    }
+
+    if(p.finished() and rdr.frameIndex > p.lastFrame()) {
+        printFrameTimes(replayFrameTimes.items);
+        p.deinit();
+        player = null;
+        sapp.quit();
+    }
+}
+
+fn printFrameTimes(times: []u64) void
+{
+    if(times.len == 0) return;
+    std.sort.sort(u64, times, {}, comptime std.sort.asc(u64));
+    var total: u64 = 0;
+    for(times) |t| {
+        total += t;
+    }
+    std.debug.print("replay: {d} frames, mean {d:.3} ms, median {d:.3} ms, p99 {d:.3} ms, max {d:.3} ms\n", .{
+        times.len,
+        stm.ms(total) / @intToFloat(f64, times.len),
+        stm.ms(times[times.len / 2]),
+        stm.ms(times[(times.len * 99 + 99) / 100 - 1]),
+        stm.ms(times[times.len - 1]),
+    });
+}
+
+// fnv-1a over the tick count and every live column, the parallel phases only
+// split work, so the same seed and tick count always give the same hash
+fn stateHash() u64
+{
+    var h = std.hash.Fnv1a_64.init();
+    h.update(std.mem.asBytes(&game.tick));
+    h.update(std.mem.asBytes(&game.foodSpawnBudget));
+    inline for(std.meta.fields(Agent)) |field| {
+        h.update(std.mem.sliceAsBytes(game.agents.items(@field(AgentStore.Field, field.name))));
+    }
+    inline for(std.meta.fields(Food)) |field| {
+        h.update(std.mem.sliceAsBytes(game.foods.items(@field(FoodStore.Field, field.name))));
+    }
+    return h.final();
+}
+
+// steps the simulation as fast as possible, no window and no gpu involved
+fn runHeadless() !void
+{
+    const out = std.io.getStdOut().writer();
+
+    stm.setup();
+    prof.setThreadName("main");
+    const seed = options.seed orelse 0;
+    initSim(seed);
+    defer jobSystem.deinit();
+    defer snapSaver.deinit();
+    if(options.load) |path| try loadWorld(path);
+
+    const graph = &game.tickGraph;
+    graph.clock = stm.now;
+    var phaseTicks = [_]u64{0} ** jobs.max_tasks;
+
+    const start = stm.now();
+    var tick: u64 = 0;
+    while(tick < options.ticks) {
+        simTick(SIM_DT);
+        var id: jobs.TaskId = 0;
+        while(id < graph.count) {
+            phaseTicks[id] += graph.taskTicks(id);
+            id += 1;
+        }
+        tick += 1;
+    }
+    const elapsed = stm.sec(stm.since(start));
+
+    try out.print("{d} ticks, seed {d}, {d} workers\n", .{ options.ticks, seed, jobSystem.workerCount() });
+    try out.print("{d:.1} ticks/s ({d:.3} s)\n", .{ @intToFloat(f64, options.ticks) / elapsed, elapsed });
+    try out.print("{s:<12} {s:>12} {s:>10}\n", .{ "phase", "total ms", "us/tick" });
+    var id: jobs.TaskId = 0;
+    while(id < graph.count) {
+        const ms = stm.ms(phaseTicks[id]);
+        try out.print("{s:<12} {d:>12.3} {d:>10.3}\n", .{
+            graph.taskName(id), ms, ms * 1000.0 / @intToFloat(f64, std.math.max(options.ticks, 1))
+        });
+        id += 1;
+    }
+    try out.print("agents {d}, food {d}\n", .{ game.agents.len, game.foods.len });
+    try out.print("tick arena high water {d} bytes\n", .{ game.tickArena.highWater });
+    try out.print("state hash 0x{x:0>16}\n", .{ stateHash() });
+
+    if(options.save) |path| {
+        try saveWorld(path);
+        try snapSaver.wait();
+        try out.print("saved {s}\n", .{ path });
+    }
+    if(options.trace) |path| {
+        try prof.writeChromeTrace(global_allocator, path);
+        try out.print("trace written to {s}\n", .{ path });
+    }
+}
+
+const Options = struct {
+    headless: bool = false,
+    ticks: u64 = 10000,
+    seed: ?u64 = null, // random when not given, 0 in headless mode
+    load: ?[]const u8 = null,
+    save: ?[]const u8 = null,
+    trace: ?[]const u8 = null,
+    record: ?[]const u8 = null,
+    replay: ?[]const u8 = null,
+};
+
+const usage =
+    \\usage: life [--headless] [--ticks N] [--seed N] [--load FILE] [--save FILE] [--trace FILE]
+    \\            [--record FILE | --replay FILE]
+    \\  --headless  run the simulation without a window and print timings
+    \\  --ticks N   ticks to run in headless mode (default 10000)
+    \\  --seed N    world seed
+    \\  --load FILE start from a snapshot
+    \\  --save FILE snapshot the world at the end of a headless run
+    \\  --trace FILE write a Chrome trace at the end of a headless run
+    \\  --record FILE record the input of the session
+    \\  --replay FILE replay a recorded session, print frame times and quit
+    \\
+;
+
+fn parseIntArg(args: *std.process.ArgIterator) !u64
+{
+    const value = try (args.next(global_allocator) orelse return error.MissingValue);
+    defer global_allocator.free(value);
+    return std.fmt.parseInt(u64, value, 10);
+}
+
+fn parseArgs() !Options
+{
+    var result: Options = .{};
+    var args = std.process.args();
+    _ = args.skip();
+    while(args.next(global_allocator)) |argOrErr| {
+        const arg = try argOrErr;
+        defer global_allocator.free(arg);
+
+        if(std.mem.eql(u8, arg, "--headless")) {
+            result.headless = true;
+        }
+        else if(std.mem.eql(u8, arg, "--ticks")) {
+            result.ticks = try parseIntArg(&args);
+        }
+        else if(std.mem.eql(u8, arg, "--seed")) {
+            result.seed = try parseIntArg(&args);
+        }
+        else if(std.mem.eql(u8, arg, "--load")) {
+            result.load = try (args.next(global_allocator) orelse return error.MissingValue);
+        }
+        else if(std.mem.eql(u8, arg, "--save")) {
+            result.save = try (args.next(global_allocator) orelse return error.MissingValue);
+        }
+        else if(std.mem.eql(u8, arg, "--trace")) {
+            result.trace = try (args.next(global_allocator) orelse return error.MissingValue);
+        }
+        else if(std.mem.eql(u8, arg, "--record")) {
+            result.record = try (args.next(global_allocator) orelse return error.MissingValue);
+        }
+        else if(std.mem.eql(u8, arg, "--replay")) {
+            result.replay = try (args.next(global_allocator) orelse return error.MissingValue);
+        }
+        else {
+            return error.UnknownArgument;
+        }
+    }
+    // input only exists with a window, and a replay isn't recorded again
+    if((result.record != null or result.replay != null) and result.headless) return error.ConflictingArguments;
+    if(result.record != null and result.replay != null) return error.ConflictingArguments;
+    return result;
+}
+
 pub fn main() void
 {
+    options = parseArgs() catch |err| {
+        std.debug.print("{s}\n{s}", .{ @errorName(err), usage });
+        std.process.exit(1);
+    };
+
+    if(options.headless) {
+        runHeadless() catch |err| {
+            std.debug.print("headless run failed: {s}\n", .{ @errorName(err) });
+            std.process.exit(1);
+        };
+        return;
+    }
+
+    if(options.replay) |path| {
+        player = replay.Player.open(global_allocator, path) catch |err| {
+            std.debug.print("failed to open {s}: {s}\n", .{ path, @errorName(err) });
+            std.process.exit(1);
+        };
+        options.seed = player.?.seed; // same world as the recording
+    }
+
     sapp.run(.{
         .init_cb = init,
         .frame_cb = frame,
@@ -212,4 +1538,4 @@ pub fn main() void
         .height = 1080,
         .window_title = "Life"
     });
-}
\ No newline at end of file
+}
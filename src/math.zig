@@ -5,6 +5,9 @@
 //  the sokol-samples
 //
 //  Ported from HandmadeMath.h
+//
+//  the Mat4 functions use @Vector(4, f32) columns, the *Scalar versions are
+//  the reference
 //------------------------------------------------------------------------------
 const assert = @import("std").debug.assert;
 const math = @import("std").math;
@@ -95,6 +98,16 @@ pub const Vec3 = packed struct {
     }
 };
 
+pub const Vec4 = packed struct {
+    x: f32, y: f32, z: f32, w: f32,
+
+    pub fn new(x: f32, y: f32, z: f32, w: f32) Vec4 {
+        return Vec4 { .x=x, .y=y, .z=z, .w=w };
+    }
+};
+
+const F32x4 = @Vector(4, f32);
+
 pub const Mat4 = packed struct {
     m: [4][4]f32,
 
@@ -120,7 +133,31 @@ pub const Mat4 = packed struct {
         };
     }
 
+    // column-major: column c of the product is left applied to column c of right
     pub fn mul(left: Mat4, right: Mat4) Mat4 {
+        var res: Mat4 = undefined;
+        comptime var col = 0;
+        inline while (col < 4): (col += 1) {
+            res.m[col] = left.apply(right.m[col]);
+        }
+        return res;
+    }
+
+    // m * v as a weighted sum of the columns
+    fn apply(m: Mat4, v: [4]f32) F32x4 {
+        const c0: F32x4 = m.m[0];
+        const c1: F32x4 = m.m[1];
+        const c2: F32x4 = m.m[2];
+        const c3: F32x4 = m.m[3];
+        return c0 * @splat(4, v[0]) + c1 * @splat(4, v[1]) + c2 * @splat(4, v[2]) + c3 * @splat(4, v[3]);
+    }
+
+    pub fn mulVec4(m: Mat4, v: Vec4) Vec4 {
+        const r = m.apply(.{ v.x, v.y, v.z, v.w });
+        return Vec4.new(r[0], r[1], r[2], r[3]);
+    }
+
+    pub fn mulScalar(left: Mat4, right: Mat4) Mat4 {
         var res = Mat4.zero();
         var col: usize = 0;
         while (col < 4): (col += 1) {
@@ -218,6 +255,76 @@ pub const Mat4 = packed struct {
         res.m[3][2] = translation.z;
         return res;
     }
+
+    pub fn mulVec4Scalar(m: Mat4, v: Vec4) Vec4 {
+        var res: [4]f32 = undefined;
+        for (res) |*r, row| {
+            r.* = m.m[0][row] * v.x + m.m[1][row] * v.y + m.m[2][row] * v.z + m.m[3][row] * v.w;
+        }
+        return Vec4.new(res[0], res[1], res[2], res[3]);
+    }
+
+    // batch transforms of points (w = 1, z = 0 for Vec2), out must be as long
+    // as in; no perspective divide, meant for affine and ortho matrices
+    //
+    // the vector versions go 4 points at a time, one coordinate per lane
+    pub fn transformPoints2(m: Mat4, in: []const Vec2, out: []Vec2) void {
+        assert(out.len >= in.len);
+        var i: usize = 0;
+        while (i + 4 <= in.len): (i += 4) {
+            const p = in[i..][0..4];
+            const x = F32x4 { p[0].x, p[1].x, p[2].x, p[3].x };
+            const y = F32x4 { p[0].y, p[1].y, p[2].y, p[3].y };
+            const ox = @splat(4, m.m[0][0]) * x + @splat(4, m.m[1][0]) * y + @splat(4, m.m[3][0]);
+            const oy = @splat(4, m.m[0][1]) * x + @splat(4, m.m[1][1]) * y + @splat(4, m.m[3][1]);
+            comptime var lane = 0;
+            inline while (lane < 4): (lane += 1) {
+                out[i + lane] = Vec2.new(ox[lane], oy[lane]);
+            }
+        }
+        transformPoints2Scalar(m, in[i..], out[i..]);
+    }
+
+    pub fn transformPoints2Scalar(m: Mat4, in: []const Vec2, out: []Vec2) void {
+        assert(out.len >= in.len);
+        for (in) |p, i| {
+            out[i] = Vec2.new(m.m[0][0] * p.x + m.m[1][0] * p.y + m.m[3][0],
+                              m.m[0][1] * p.x + m.m[1][1] * p.y + m.m[3][1]);
+        }
+    }
+
+    pub fn transformPoints3(m: Mat4, in: []const Vec3, out: []Vec3) void {
+        assert(out.len >= in.len);
+        var i: usize = 0;
+        while (i + 4 <= in.len): (i += 4) {
+            const p = in[i..][0..4];
+            const x = F32x4 { p[0].x, p[1].x, p[2].x, p[3].x };
+            const y = F32x4 { p[0].y, p[1].y, p[2].y, p[3].y };
+            const z = F32x4 { p[0].z, p[1].z, p[2].z, p[3].z };
+            var o: [3]F32x4 = undefined;
+            comptime var row = 0;
+            inline while (row < 3): (row += 1) {
+                o[row] = @splat(4, m.m[0][row]) * x + @splat(4, m.m[1][row]) * y +
+                         @splat(4, m.m[2][row]) * z + @splat(4, m.m[3][row]);
+            }
+            comptime var lane = 0;
+            inline while (lane < 4): (lane += 1) {
+                out[i + lane] = Vec3.new(o[0][lane], o[1][lane], o[2][lane]);
+            }
+        }
+        transformPoints3Scalar(m, in[i..], out[i..]);
+    }
+
+    pub fn transformPoints3Scalar(m: Mat4, in: []const Vec3, out: []Vec3) void {
+        assert(out.len >= in.len);
+        for (in) |p, i| {
+            var res: [3]f32 = undefined;
+            for (res) |*r, row| {
+                r.* = m.m[0][row] * p.x + m.m[1][row] * p.y + m.m[2][row] * p.z + m.m[3][row];
+            }
+            out[i] = Vec3.new(res[0], res[1], res[2]);
+        }
+    }
 };
 
 test "Vec3.zero" {
@@ -337,5 +444,59 @@ test "Mat4.rotate" {
     assert(eq(m.m[3][3], 1.0));
 }
 
+fn testMatrix() Mat4 {
+    const view = Mat4.lookat(.{ .x=0.0, .y=1.5, .z=6.0 }, Vec3.zero(), Vec3.up());
+    const model = Mat4.mulScalar(Mat4.translate(Vec3.new(1.0, -2.0, 0.5)), Mat4.rotate(33.0, Vec3.new(1.0, 2.0, 3.0)));
+    return Mat4.mulScalar(Mat4.persp(60.0, 1.33333337, 0.01, 10.0), Mat4.mulScalar(view, model));
+}
 
+fn bitEq(a: f32, b: f32) bool {
+    return @bitCast(u32, a) == @bitCast(u32, b);
+}
 
+test "Mat4.mul matches Mat4.mulScalar" {
+    const a = testMatrix();
+    const b = Mat4.rotate(-71.0, Vec3.new(0.0, 0.0, 1.0));
+    const simd = Mat4.mul(a, b);
+    const scalar = Mat4.mulScalar(a, b);
+    for (simd.m) |col, c| {
+        for (col) |val, r| {
+            assert(bitEq(val, scalar.m[c][r]));
+        }
+    }
+
+    const v = Vec4.new(0.5, -3.0, 2.0, 1.0);
+    const mv = Mat4.mulVec4(a, v);
+    const mvs = Mat4.mulVec4Scalar(a, v);
+    assert(bitEq(mv.x, mvs.x) and bitEq(mv.y, mvs.y) and bitEq(mv.z, mvs.z) and bitEq(mv.w, mvs.w));
+}
+
+test "Mat4.transformPoints matches the scalar versions, remainders included" {
+    const m = testMatrix();
+    var in2: [11]Vec2 = undefined;
+    var in3: [11]Vec3 = undefined;
+    for (in2) |*p, i| {
+        const f = @intToFloat(f32, i);
+        p.* = Vec2.new(f * 1.5 - 4.0, 3.0 - f * 0.25);
+        in3[i] = Vec3.new(p.x, p.y, f * 0.125);
+    }
+
+    var n: usize = 0;
+    while (n <= in2.len): (n += 1) {
+        var out2: [11]Vec2 = undefined;
+        var ref2: [11]Vec2 = undefined;
+        Mat4.transformPoints2(m, in2[0..n], &out2);
+        Mat4.transformPoints2Scalar(m, in2[0..n], &ref2);
+        for (out2[0..n]) |p, i| {
+            assert(bitEq(p.x, ref2[i].x) and bitEq(p.y, ref2[i].y));
+        }
+
+        var out3: [11]Vec3 = undefined;
+        var ref3: [11]Vec3 = undefined;
+        Mat4.transformPoints3(m, in3[0..n], &out3);
+        Mat4.transformPoints3Scalar(m, in3[0..n], &ref3);
+        for (out3[0..n]) |p, i| {
+            assert(bitEq(p.x, ref3[i].x) and bitEq(p.y, ref3[i].y) and bitEq(p.z, ref3[i].z));
+        }
+    }
+}
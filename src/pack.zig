@@ -0,0 +1,217 @@
+//------------------------------------------------------------------------------
+//  pack.zig
+//
+//  baked asset pack, written by tools/bake_assets.zig ('zig build assets')
+//  and memory mapped by the game at startup
+//
+//  layout, native little endian:
+//      Header
+//      ImageRecord[image_count]
+//      pixel data, each mip level aligned to data_align
+//
+//  pixel data is GPU ready (RGBA8, mip levels included), so the mapped bytes go
+//  straight to sg.makeImage without decoding or copying
+//------------------------------------------------------------------------------
+const std = @import("std");
+const os = std.os;
+const assert = std.debug.assert;
+const testfiles = @import("testfiles.zig");
+
+comptime {
+    if (std.Target.current.cpu.arch.endian() != .Little) {
+        @compileError("asset packs are little endian");
+    }
+}
+
+pub const magic = [4]u8 { 'L', 'P', 'A', 'K' };
+pub const version: u32 = 1;
+pub const data_align = 256;
+pub const max_mips = 16;
+
+pub const Header = extern struct {
+    magic: [4]u8 = magic,
+    version: u32 = version,
+    image_count: u32,
+    reserved: u32 = 0,
+};
+
+pub const Mip = extern struct {
+    offset: u64 = 0,
+    size: u64 = 0,
+};
+
+pub const ImageRecord = extern struct {
+    width: u32,
+    height: u32,
+    mip_count: u32,
+    reserved: u32 = 0,
+    mips: [max_mips]Mip = [_]Mip{.{}} ** max_mips,
+};
+
+pub const Error = error {
+    InvalidMagic,
+    InvalidVersion,
+    Truncated,
+    InvalidMipSize, // doesn't hold the texels its level needs
+};
+
+pub const Pack = struct {
+    bytes: []align(std.mem.page_size) const u8,
+    // only used where mmap is not available
+    allocator: ?*std.mem.Allocator = null,
+
+    pub fn open(allocator: *std.mem.Allocator, path: []const u8) !Pack {
+        var pack: Pack = undefined;
+        if (std.builtin.os.tag == .windows) {
+            const bytes = try std.fs.cwd().readFileAllocOptions(allocator, path, std.math.maxInt(u32), null, std.mem.page_size, null);
+            pack = .{ .bytes = bytes, .allocator = allocator };
+        }
+        else {
+            const file = try std.fs.cwd().openFile(path, .{});
+            defer file.close();
+            const size = try file.getEndPos();
+            if (size < @sizeOf(Header)) return error.Truncated;
+            const bytes = try os.mmap(null, size, os.PROT_READ, os.MAP_PRIVATE, file.handle, 0);
+            pack = .{ .bytes = bytes };
+        }
+        errdefer pack.close();
+        try pack.validate();
+        return pack;
+    }
+
+    pub fn close(self: *Pack) void {
+        if (self.allocator) |allocator| {
+            allocator.free(self.bytes);
+        }
+        else {
+            os.munmap(self.bytes);
+        }
+        self.* = undefined;
+    }
+
+    fn validate(self: Pack) Error!void {
+        if (self.bytes.len < @sizeOf(Header)) return error.Truncated;
+        const hdr = self.header();
+        if (!std.mem.eql(u8, &hdr.magic, &magic)) return error.InvalidMagic;
+        if (hdr.version != version) return error.InvalidVersion;
+        if (self.bytes.len < @sizeOf(Header) + @as(usize, hdr.image_count) * @sizeOf(ImageRecord)) return error.Truncated;
+        for (self.images()) |rec| {
+            if (rec.mip_count == 0 or rec.mip_count > max_mips) return error.Truncated;
+            if (rec.width == 0 or rec.height == 0) return error.InvalidMipSize;
+            for (rec.mips[0..rec.mip_count]) |mip, level| {
+                if (mip.size > self.bytes.len or mip.offset > self.bytes.len - mip.size) return error.Truncated;
+                // the bytes go to the GPU as is, they must be exactly the RGBA8 level
+                if (mip.size != mipSize(rec, level)) return error.InvalidMipSize;
+            }
+        }
+    }
+
+    fn mipSize(rec: ImageRecord, level: usize) u64 {
+        const shift = @intCast(u5, level);
+        const w: u64 = std.math.max(rec.width >> shift, 1);
+        const h: u64 = std.math.max(rec.height >> shift, 1);
+        return w * h * 4;
+    }
+
+    pub fn header(self: Pack) *const Header {
+        return @ptrCast(*const Header, self.bytes.ptr);
+    }
+
+    pub fn images(self: Pack) []const ImageRecord {
+        const ptr = @ptrCast([*]const ImageRecord, @alignCast(@alignOf(ImageRecord), self.bytes.ptr + @sizeOf(Header)));
+        return ptr[0..self.header().image_count];
+    }
+
+    pub fn mipData(self: Pack, rec: ImageRecord, level: usize) []const u8 {
+        const mip = rec.mips[level];
+        return self.bytes[@intCast(usize, mip.offset)..][0..@intCast(usize, mip.size)];
+    }
+};
+
+//------------------------------------------------------------------------------
+//  tests
+//------------------------------------------------------------------------------
+// a 2x2 image with two mips, the 1x1 one ends the file
+const test_data = std.mem.alignForward(@sizeOf(Header) + @sizeOf(ImageRecord), data_align);
+const test_file_size = test_data + 2 * data_align;
+const test_header = Header { .image_count = 1 };
+const test_image = ImageRecord {
+    .width = 2,
+    .height = 2,
+    .mip_count = 2,
+    .mips = [_]Mip{
+        .{ .offset = test_data, .size = 16 },
+        .{ .offset = test_data + data_align, .size = 4 },
+    } ++ [_]Mip{.{}} ** (max_mips - 2),
+};
+
+// the first len bytes of a pack starting with hdr and rec, the pixels of
+// mip level n are all n + 1
+fn writeTestPack(file: testfiles.TmpFile, hdr: Header, rec: ImageRecord, len: usize) !void {
+    var bytes = [_]u8{0} ** test_file_size;
+    std.mem.copy(u8, &bytes, std.mem.asBytes(&hdr));
+    std.mem.copy(u8, bytes[@sizeOf(Header)..], std.mem.asBytes(&rec));
+    std.mem.set(u8, bytes[test_data..][0..16], 1);
+    std.mem.set(u8, bytes[test_data + data_align..][0..4], 2);
+    try file.write(bytes[0..len]);
+}
+
+fn expectRejected(file: testfiles.TmpFile, expected: anyerror, hdr: Header, rec: ImageRecord, len: usize) !void {
+    try writeTestPack(file, hdr, rec, len);
+    try testfiles.expectOpenError(Pack, expected, file.path);
+}
+
+test "Pack.open maps a valid pack" {
+    var file = try testfiles.TmpFile.init("test.pack");
+    defer file.deinit();
+
+    try writeTestPack(file, test_header, test_image, test_file_size);
+    var pack = try Pack.open(std.testing.allocator, file.path);
+    defer pack.close();
+    assert(pack.images().len == 1);
+    const rec = pack.images()[0];
+    assert(rec.width == 2 and rec.height == 2 and rec.mip_count == 2);
+    assert(std.mem.eql(u8, pack.mipData(rec, 0), &[_]u8{1} ** 16));
+    assert(std.mem.eql(u8, pack.mipData(rec, 1), &[_]u8{2} ** 4));
+}
+
+test "Pack.open rejects malformed packs" {
+    var file = try testfiles.TmpFile.init("test.pack");
+    defer file.deinit();
+
+    var hdr = test_header;
+    hdr.magic[0] = 'X';
+    try expectRejected(file, error.InvalidMagic, hdr, test_image, test_file_size);
+
+    hdr = test_header;
+    hdr.version = version + 1;
+    try expectRejected(file, error.InvalidVersion, hdr, test_image, test_file_size);
+
+    // cut in the header, in the image records, in the last mip
+    try expectRejected(file, error.Truncated, test_header, test_image, @sizeOf(Header) / 2);
+    try expectRejected(file, error.Truncated, test_header, test_image, @sizeOf(Header) + @sizeOf(ImageRecord) / 2);
+    try expectRejected(file, error.Truncated, test_header, test_image, test_data + data_align + 2);
+
+    hdr = test_header;
+    hdr.image_count = 1000;
+    try expectRejected(file, error.Truncated, hdr, test_image, test_file_size);
+
+    var rec = test_image;
+    rec.mip_count = 0;
+    try expectRejected(file, error.Truncated, test_header, rec, test_file_size);
+    rec.mip_count = max_mips + 1;
+    try expectRejected(file, error.Truncated, test_header, rec, test_file_size);
+
+    // mips too small or too large for the image
+    rec = test_image;
+    rec.mips[1].size = 3;
+    try expectRejected(file, error.InvalidMipSize, test_header, rec, test_file_size);
+    rec = test_image;
+    rec.width = 4;
+    try expectRejected(file, error.InvalidMipSize, test_header, rec, test_file_size);
+
+    // a mip past the end whose offset + size wraps around into the file
+    rec = test_image;
+    rec.mips[1] = .{ .offset = std.math.maxInt(u64) - 3, .size = 8 };
+    try expectRejected(file, error.Truncated, test_header, rec, test_file_size);
+}
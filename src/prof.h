@@ -0,0 +1,27 @@
+/*
+    prof.h
+
+    C side of the zone profiler, implemented in prof.zig
+
+        prof_begin("name");
+        ...
+        prof_end();
+
+    zones nest and must be balanced on each thread, names must be string
+    literals (they are kept, not copied)
+*/
+#ifndef LIFE_PROF_H
+#define LIFE_PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void prof_begin(const char* name);
+void prof_end(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIFE_PROF_H */
@@ -0,0 +1,270 @@
+//------------------------------------------------------------------------------
+//  prof.zig
+//
+//  zone based CPU profiler
+//
+//      const zone = prof.begin("name");
+//      defer zone.end();
+//
+//  C code uses prof_begin("name") / prof_end() from prof.h.
+//
+//  every thread records into its own ring of events (one writer, so no locks
+//  and no atomics beyond publishing the write index), stamped with
+//  sokol_time ticks. Readers copy the recent part of every ring to build the
+//  overlay summary or a Chrome trace_event file (chrome://tracing, Perfetto).
+//------------------------------------------------------------------------------
+const std = @import("std");
+const stm = @import("sokol").time;
+const mem = std.mem;
+
+pub const max_threads = 64;
+pub const events_per_thread = 1 << 16;
+const max_depth = 32;
+// events this close to being overwritten are not trusted by readers
+const read_slack = 1024;
+
+pub const Event = struct {
+    name: []const u8,
+    begin: u64,
+    end: u64,
+    depth: u32,
+};
+
+const ThreadBuffer = struct {
+    events: []Event,
+    head: u64 = 0, // events written so far, published with release
+    id: u32,
+    name: [32]u8 = [_]u8{0} ** 32,
+    nameLen: usize = 0,
+    depth: u32 = 0,
+    // open zones of the C api, which has no Zone value to carry them
+    cStack: [max_depth]Zone = undefined,
+    cDepth: u32 = 0,
+
+    fn push(self: *ThreadBuffer, event: Event) void {
+        const h = self.head; // we are the only writer
+        self.events[h & (events_per_thread - 1)] = event;
+        @atomicStore(u64, &self.head, h + 1, .Release);
+    }
+};
+
+// ThreadBuffer pointers as usize so readers can load them atomically
+var threadSlots: [max_threads]usize = [_]usize{0} ** max_threads;
+var threadCount: u32 = 0; // never above max_threads
+threadlocal var tls_buffer: ?*ThreadBuffer = null;
+// no slot left or out of memory, the thread records nothing
+threadlocal var tls_failed: bool = false;
+
+pub var enabled: bool = true;
+
+fn current() ?*ThreadBuffer {
+    if (tls_buffer) |buffer| return buffer;
+    if (tls_failed) return null;
+
+    var id = @atomicLoad(u32, &threadCount, .Acquire);
+    while (true) {
+        if (id >= max_threads) {
+            tls_failed = true;
+            return null;
+        }
+        id = @cmpxchgWeak(u32, &threadCount, id, id + 1, .AcqRel, .Acquire) orelse break;
+    }
+    const allocator = std.heap.page_allocator;
+    const buffer = allocator.create(ThreadBuffer) catch {
+        tls_failed = true;
+        return null;
+    };
+    buffer.* = .{
+        .events = allocator.alloc(Event, events_per_thread) catch {
+            allocator.destroy(buffer);
+            tls_failed = true;
+            return null;
+        },
+        .id = id,
+    };
+    tls_buffer = buffer;
+    @atomicStore(usize, &threadSlots[id], @ptrToInt(buffer), .Release);
+    return buffer;
+}
+
+fn threadAt(index: usize) ?*ThreadBuffer {
+    const ptr = @atomicLoad(usize, &threadSlots[index], .Acquire);
+    return if (ptr != 0) @intToPtr(*ThreadBuffer, ptr) else null;
+}
+
+// shows up in the trace and the overlay instead of the thread id
+pub fn setThreadName(name: []const u8) void {
+    const buffer = current() orelse return;
+    buffer.nameLen = std.math.min(name.len, buffer.name.len);
+    mem.copy(u8, &buffer.name, name[0..buffer.nameLen]);
+}
+
+pub const Zone = struct {
+    buffer: ?*ThreadBuffer,
+    name: []const u8,
+    start: u64,
+    depth: u32,
+
+    pub fn end(self: Zone) void {
+        const buffer = self.buffer orelse return;
+        buffer.depth = self.depth;
+        buffer.push(.{ .name = self.name, .begin = self.start, .end = stm.now(), .depth = self.depth });
+    }
+};
+
+// name must outlive the profiler, string literals are the norm
+pub fn begin(name: []const u8) Zone {
+    if (!@atomicLoad(bool, &enabled, .Monotonic)) return .{ .buffer = null, .name = name, .start = 0, .depth = 0 };
+    const buffer = current() orelse return .{ .buffer = null, .name = name, .start = 0, .depth = 0 };
+    const depth = buffer.depth;
+    buffer.depth += 1;
+    return .{ .buffer = buffer, .name = name, .start = stm.now(), .depth = depth };
+}
+
+//------------------------------------------------------------------------------
+//  C api, see prof.h
+//------------------------------------------------------------------------------
+export fn prof_begin(name: [*:0]const u8) void {
+    const buffer = current() orelse return;
+    if (buffer.cDepth >= max_depth) {
+        buffer.cDepth += 1; // still has to balance prof_end
+        return;
+    }
+    buffer.cStack[buffer.cDepth] = begin(mem.spanZ(name));
+    buffer.cDepth += 1;
+}
+
+export fn prof_end() void {
+    const buffer = current() orelse return;
+    if (buffer.cDepth == 0) return;
+    buffer.cDepth -= 1;
+    if (buffer.cDepth < max_depth) {
+        buffer.cStack[buffer.cDepth].end();
+    }
+}
+
+//------------------------------------------------------------------------------
+//  readers
+//------------------------------------------------------------------------------
+pub const ThreadEvent = struct {
+    thread: u32,
+    index: u64, // position in the thread's ring
+    event: Event,
+};
+
+// appends every event of every thread that ended after since (stm ticks)
+pub fn collect(since: u64, out: *std.ArrayList(ThreadEvent)) !void {
+    const count = std.math.min(@atomicLoad(u32, &threadCount, .Acquire), max_threads);
+    var t: usize = 0;
+    while (t < count): (t += 1) {
+        const buffer = threadAt(t) orelse continue;
+        const head = @atomicLoad(u64, &buffer.head, .Acquire);
+        const available = std.math.min(head, events_per_thread - read_slack);
+        const first = out.items.len;
+
+        var i = head - available;
+        while (i < head): (i += 1) {
+            const event = buffer.events[i & (events_per_thread - 1)];
+            if (event.end < since) continue;
+            try out.append(.{ .thread = buffer.id, .index = i, .event = event });
+        }
+
+        // the writer kept going while we copied, drop the events it may
+        // have overwritten
+        const newHead = @atomicLoad(u64, &buffer.head, .Acquire);
+        if (newHead >= events_per_thread) {
+            var keep = first;
+            for (out.items[first..]) |te| {
+                if (te.index + events_per_thread > newHead) {
+                    out.items[keep] = te;
+                    keep += 1;
+                }
+            }
+            out.shrinkRetainingCapacity(keep);
+        }
+    }
+}
+
+pub fn threadName(id: u32) []const u8 {
+    const buffer = threadAt(id) orelse return "";
+    return buffer.name[0..buffer.nameLen];
+}
+
+pub const ZoneStat = struct {
+    thread: u32,
+    name: []const u8,
+    depth: u32,
+    calls: u32 = 0,
+    total: u64 = 0,
+    max: u64 = 0,
+    first: u64, // earliest start, keeps the summary in call order
+};
+
+fn statLessThan(context: void, a: ZoneStat, b: ZoneStat) bool {
+    if (a.thread != b.thread) return a.thread < b.thread;
+    return a.first < b.first;
+}
+
+// zones since the given tick merged by thread and name, sorted by thread
+// then by first call so nested zones follow their parent
+pub fn summarize(allocator: *mem.Allocator, since: u64) ![]ZoneStat {
+    var events = std.ArrayList(ThreadEvent).init(allocator);
+    defer events.deinit();
+    try collect(since, &events);
+
+    var stats = std.ArrayList(ZoneStat).init(allocator);
+    errdefer stats.deinit();
+    for (events.items) |te| {
+        const ev = te.event;
+        const dur = ev.end -% ev.begin;
+        const stat = for (stats.items) |*s| {
+            if (s.thread == te.thread and s.depth == ev.depth and mem.eql(u8, s.name, ev.name)) break s;
+        } else blk: {
+            try stats.append(.{ .thread = te.thread, .name = ev.name, .depth = ev.depth, .first = ev.begin });
+            break :blk &stats.items[stats.items.len - 1];
+        };
+        stat.calls += 1;
+        stat.total += dur;
+        stat.max = std.math.max(stat.max, dur);
+        stat.first = std.math.min(stat.first, ev.begin);
+    }
+    std.sort.sort(ZoneStat, stats.items, {}, statLessThan);
+    return stats.toOwnedSlice();
+}
+
+// everything still in the rings as Chrome trace_event json
+pub fn writeChromeTrace(allocator: *mem.Allocator, path: []const u8) !void {
+    var events = std.ArrayList(ThreadEvent).init(allocator);
+    defer events.deinit();
+    try collect(0, &events);
+
+    const file = try std.fs.cwd().createFile(path, .{});
+    defer file.close();
+    var buffered = std.io.bufferedWriter(file.writer());
+    const w = buffered.writer();
+
+    try w.writeAll("{\"traceEvents\":[\n");
+    var first = true;
+    const count = std.math.min(@atomicLoad(u32, &threadCount, .Acquire), max_threads);
+    var t: u32 = 0;
+    while (t < count): (t += 1) {
+        if (threadAt(t) == null) continue;
+        if (!first) try w.writeAll(",\n");
+        first = false;
+        try w.print("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{d},\"args\":{{\"name\":", .{ t });
+        try std.json.stringify(threadName(t), .{}, w);
+        try w.writeAll("}}");
+    }
+    for (events.items) |te| {
+        const ev = te.event;
+        if (!first) try w.writeAll(",\n");
+        first = false;
+        try w.writeAll("{\"name\":");
+        try std.json.stringify(ev.name, .{}, w);
+        try w.print(",\"ph\":\"X\",\"pid\":0,\"tid\":{d},\"ts\":{d:.3},\"dur\":{d:.3}}}", .{
+            te.thread, stm.us(ev.begin), stm.us(ev.end -% ev.begin)
+        });
+    }
+    try w.writeAll("\n]}\n");
+    try buffered.flush();
+}
@@ -0,0 +1,184 @@
+//------------------------------------------------------------------------------
+//  replay.zig
+//
+//  input recording and replay
+//
+//  a recording holds every sapp event the game handled, stamped with the
+//  frame it arrived in, so a replay feeds it back through the same input
+//  path on the same frame. The world seed comes along and a replay starts
+//  from the same world. The simulation still follows the wall clock, so a
+//  replay reproduces the session (zoom storms, snapshot requests, ...)
+//  rather than a bit exact game state: what a performance run needs.
+//
+//  layout, native little endian: Header, then one Record per event
+//------------------------------------------------------------------------------
+const std = @import("std");
+const sapp = @import("sokol").app;
+const stm = @import("sokol").time;
+const mem = std.mem;
+
+pub const magic = [4]u8 { 'L', 'R', 'E', 'C' };
+pub const version: u32 = 1;
+
+pub const Header = extern struct {
+    magic: [4]u8 = magic,
+    version: u32 = version,
+    seed: u64,
+};
+
+// the part of sapp.Event the game looks at
+pub const Record = extern struct {
+    frame: u32,
+    time_us: u32, // since the recording started
+    type: u8, // sapp.EventType
+    mouse_button: u8, // sapp.Mousebutton
+    key_repeat: u8,
+    reserved: u8 = 0,
+    key_code: u16, // sapp.Keycode
+    modifiers: u16,
+    mouse_x: f32,
+    mouse_y: f32,
+    mouse_dx: f32,
+    mouse_dy: f32,
+    scroll_x: f32,
+    scroll_y: f32,
+
+    pub fn fromEvent(frame: u32, time_us: u32, ev: *const sapp.Event) Record {
+        return .{
+            .frame = frame,
+            .time_us = time_us,
+            .type = @intCast(u8, @enumToInt(ev.type)),
+            .mouse_button = @intCast(u8, @enumToInt(ev.mouse_button)),
+            .key_repeat = @boolToInt(ev.key_repeat),
+            .key_code = @intCast(u16, @enumToInt(ev.key_code)),
+            .modifiers = @truncate(u16, ev.modifiers),
+            .mouse_x = ev.mouse_x,
+            .mouse_y = ev.mouse_y,
+            .mouse_dx = ev.mouse_dx,
+            .mouse_dy = ev.mouse_dy,
+            .scroll_x = ev.scroll_x,
+            .scroll_y = ev.scroll_y,
+        };
+    }
+
+    pub fn toEvent(self: Record) sapp.Event {
+        return .{
+            .frame_count = self.frame,
+            .type = @intToEnum(sapp.EventType, self.type),
+            .key_code = @intToEnum(sapp.Keycode, self.key_code),
+            .key_repeat = self.key_repeat != 0,
+            .modifiers = self.modifiers,
+            .mouse_button = @intToEnum(sapp.Mousebutton, self.mouse_button),
+            .mouse_x = self.mouse_x,
+            .mouse_y = self.mouse_y,
+            .mouse_dx = self.mouse_dx,
+            .mouse_dy = self.mouse_dy,
+            .scroll_x = self.scroll_x,
+            .scroll_y = self.scroll_y,
+        };
+    }
+};
+
+pub const Error = error {
+    InvalidMagic,
+    InvalidVersion,
+    Truncated,
+};
+
+//------------------------------------------------------------------------------
+//  record
+//------------------------------------------------------------------------------
+pub const Recorder = struct {
+    file: std.fs.File,
+    out: std.io.BufferedWriter(4096, std.fs.File.Writer),
+    start: u64, // stm ticks
+
+    pub fn create(path: []const u8, seed: u64) !Recorder {
+        const file = try std.fs.cwd().createFile(path, .{});
+        errdefer file.close();
+        var self = Recorder {
+            .file = file,
+            .out = std.io.bufferedWriter(file.writer()),
+            .start = stm.now(),
+        };
+        try self.out.writer().writeAll(mem.asBytes(&Header { .seed = seed }));
+        return self;
+    }
+
+    pub fn record(self: *Recorder, frame: u32, ev: *const sapp.Event) !void {
+        const elapsed = @floatToInt(u32, std.math.min(stm.us(stm.since(self.start)), std.math.maxInt(u32)));
+        const rec = Record.fromEvent(frame, elapsed, ev);
+        try self.out.writer().writeAll(mem.asBytes(&rec));
+    }
+
+    pub fn close(self: *Recorder) !void {
+        defer self.file.close();
+        try self.out.flush();
+    }
+};
+
+//------------------------------------------------------------------------------
+//  replay
+//------------------------------------------------------------------------------
+pub const Player = struct {
+    allocator: *mem.Allocator,
+    bytes: []align(@alignOf(Record)) u8,
+    seed: u64,
+    records: []const Record,
+    next: usize = 0,
+
+    pub fn open(allocator: *mem.Allocator, path: []const u8) !Player {
+        const bytes = try std.fs.cwd().readFileAllocOptions(allocator, path, std.math.maxInt(usize), null, @alignOf(Record), null);
+        errdefer allocator.free(bytes);
+        if (bytes.len < @sizeOf(Header)) return error.Truncated;
+        const hdr = mem.bytesToValue(Header, bytes[0..@sizeOf(Header)]);
+        if (!mem.eql(u8, &hdr.magic, &magic)) return error.InvalidMagic;
+        if (hdr.version != version) return error.InvalidVersion;
+        const body = bytes[@sizeOf(Header)..];
+        if (body.len % @sizeOf(Record) != 0) return error.Truncated;
+
+        return Player {
+            .allocator = allocator,
+            .bytes = bytes,
+            .seed = hdr.seed,
+            .records = mem.bytesAsSlice(Record, @alignCast(@alignOf(Record), body)),
+        };
+    }
+
+    pub fn deinit(self: *Player) void {
+        self.allocator.free(self.bytes);
+        self.* = undefined;
+    }
+
+    // the next event recorded at or before frame, in recording order
+    pub fn poll(self: *Player, frame: u32) ?sapp.Event {
+        if (self.next >= self.records.len or self.records[self.next].frame > frame) return null;
+        self.next += 1;
+        return self.records[self.next - 1].toEvent();
+    }
+
+    pub fn finished(self: Player) bool {
+        return self.next >= self.records.len;
+    }
+
+    // frame of the last event, the replay ends after it
+    pub fn lastFrame(self: Player) u32 {
+        return if (self.records.len > 0) self.records[self.records.len - 1].frame else 0;
+    }
+};
+
+test "Record round trips an event" {
+    const ev = sapp.Event {
+        .type = .MOUSE_SCROLL,
+        .key_code = .F5,
+        .modifiers = 3,
+        .mouse_button = .RIGHT,
+        .mouse_x = 10.5,
+        .scroll_y = -2.0,
+    };
+    const back = Record.fromEvent(42, 1000, &ev).toEvent();
+    std.debug.assert(back.type == .MOUSE_SCROLL and back.key_code == .F5);
+    std.debug.assert(back.modifiers == 3 and back.mouse_button == .RIGHT);
+    std.debug.assert(back.mouse_x == 10.5 and back.scroll_y == -2.0);
+    std.debug.assert(back.frame_count == 42);
+}
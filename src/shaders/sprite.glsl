@@ -0,0 +1,48 @@
+@ctype mat4 @import("../math.zig").Mat4
+
+// vertex
+@vs vs
+uniform vs_params {
+    mat4 mvp;
+};
+
+// per vertex: unit quad corner
+in vec2 position;
+
+// per instance: one sprite
+in vec2 inst_pos;
+in vec2 inst_scale;
+in float inst_rot;
+in vec4 inst_color;
+in vec4 inst_uv; // ushort4n
+
+out vec4 color;
+out vec2 uv;
+
+void main() {
+    float s = sin(inst_rot);
+    float c = cos(inst_rot);
+    vec2 p = position * inst_scale;
+    p = vec2(p.x * c - p.y * s, p.x * s + p.y * c);
+    gl_Position = mvp * vec4(p + inst_pos, 0.0, 1.0);
+    color = inst_color;
+    // atlas rect, quad y grows down like the atlas rows
+    uv = mix(inst_uv.xy, inst_uv.zw, position + 0.5);
+}
+@end
+
+// fragment
+@fs fs
+uniform sampler2D tex;
+
+in vec4 color;
+in vec2 uv;
+out vec4 frag_color;
+
+void main() {
+    frag_color = texture(tex, uv) * color;
+}
+@end
+
+// program
+@program sprite vs fs
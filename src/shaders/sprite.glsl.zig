@@ -0,0 +1,632 @@
+const sg = @import("sokol").gfx;
+//
+//  #version:1# (machine generated, don't edit!)
+//
+//  Generated by sokol-shdc (https://github.com/floooh/sokol-tools)
+//
+//  Cmdline: sokol-shdc -i sprite.glsl -o sprite.glsl.zig -l glsl330:metal_macos:hlsl4 -f sokol_zig
+//
+//  Overview:
+//
+//      Shader program 'sprite':
+//          Get shader desc: shd.spriteShaderDesc(sg.queryBackend());
+//          Vertex shader: vs
+//              Attribute slots:
+//                  ATTR_vs_position = 0
+//                  ATTR_vs_inst_pos = 1
+//                  ATTR_vs_inst_scale = 2
+//                  ATTR_vs_inst_rot = 3
+//                  ATTR_vs_inst_color = 4
+//                  ATTR_vs_inst_uv = 5
+//              Uniform block 'vs_params':
+//                  C struct: vs_params_t
+//                  Bind slot: SLOT_vs_params = 0
+//          Fragment shader: fs
+//              Image 'tex':
+//                  Type: SG_IMAGETYPE_2D
+//                  Component Type: SG_SAMPLERTYPE_FLOAT
+//                  Bind slot: SLOT_tex = 0
+//
+//
+pub const ATTR_vs_position = 0;
+pub const ATTR_vs_inst_pos = 1;
+pub const ATTR_vs_inst_scale = 2;
+pub const ATTR_vs_inst_rot = 3;
+pub const ATTR_vs_inst_color = 4;
+pub const ATTR_vs_inst_uv = 5;
+pub const SLOT_vs_params = 0;
+pub const SLOT_tex = 0;
+pub const VsParams = extern struct {
+    mvp: @import("../math.zig").Mat4 align(16),
+};
+//
+// #version 330
+// 
+// uniform vec4 vs_params[4];
+// layout(location = 3) in float inst_rot;
+// layout(location = 0) in vec2 position;
+// layout(location = 2) in vec2 inst_scale;
+// layout(location = 1) in vec2 inst_pos;
+// out vec4 color;
+// layout(location = 4) in vec4 inst_color;
+// out vec2 uv;
+// layout(location = 5) in vec4 inst_uv;
+// 
+// void main()
+// {
+//     float _14 = sin(inst_rot);
+//     float _18 = cos(inst_rot);
+//     vec2 _27 = position * inst_scale;
+//     gl_Position = mat4(vs_params[0], vs_params[1], vs_params[2], vs_params[3]) * vec4(vec2((_27.x * _18) - (_27.y * _14), (_27.x * _14) + (_27.y * _18)) + inst_pos, 0.0, 1.0);
+//     color = inst_color;
+//     uv = mix(inst_uv.xy, inst_uv.zw, position + vec2(0.5));
+// }
+// 
+//
+const vs_source_glsl330 = [687]u8 {
+    0x23,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x33,0x33,0x30,0x0a,0x0a,0x75,0x6e,
+    0x69,0x66,0x6f,0x72,0x6d,0x20,0x76,0x65,0x63,0x34,0x20,0x76,0x73,0x5f,0x70,0x61,
+    0x72,0x61,0x6d,0x73,0x5b,0x34,0x5d,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,
+    0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x33,0x29,0x20,0x69,0x6e,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x69,0x6e,0x73,0x74,0x5f,0x72,0x6f,0x74,0x3b,
+    0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,
+    0x20,0x3d,0x20,0x30,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x32,0x20,0x70,0x6f,
+    0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,
+    0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x32,0x29,0x20,0x69,0x6e,0x20,
+    0x76,0x65,0x63,0x32,0x20,0x69,0x6e,0x73,0x74,0x5f,0x73,0x63,0x61,0x6c,0x65,0x3b,
+    0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,
+    0x20,0x3d,0x20,0x31,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x32,0x20,0x69,0x6e,
+    0x73,0x74,0x5f,0x70,0x6f,0x73,0x3b,0x0a,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,0x34,
+    0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,
+    0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x34,0x29,0x20,0x69,0x6e,0x20,
+    0x76,0x65,0x63,0x34,0x20,0x69,0x6e,0x73,0x74,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x3b,
+    0x0a,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,0x32,0x20,0x75,0x76,0x3b,0x0a,0x6c,0x61,
+    0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,
+    0x35,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x34,0x20,0x69,0x6e,0x73,0x74,0x5f,
+    0x75,0x76,0x3b,0x0a,0x0a,0x76,0x6f,0x69,0x64,0x20,0x6d,0x61,0x69,0x6e,0x28,0x29,
+    0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x5f,0x31,0x34,
+    0x20,0x3d,0x20,0x73,0x69,0x6e,0x28,0x69,0x6e,0x73,0x74,0x5f,0x72,0x6f,0x74,0x29,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x5f,0x31,0x38,0x20,
+    0x3d,0x20,0x63,0x6f,0x73,0x28,0x69,0x6e,0x73,0x74,0x5f,0x72,0x6f,0x74,0x29,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x32,0x20,0x5f,0x32,0x37,0x20,0x3d,0x20,
+    0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x2a,0x20,0x69,0x6e,0x73,0x74,0x5f,
+    0x73,0x63,0x61,0x6c,0x65,0x3b,0x0a,0x20,0x20,0x20,0x20,0x67,0x6c,0x5f,0x50,0x6f,
+    0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x6d,0x61,0x74,0x34,0x28,0x76,0x73,
+    0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,0x30,0x5d,0x2c,0x20,0x76,0x73,0x5f,0x70,
+    0x61,0x72,0x61,0x6d,0x73,0x5b,0x31,0x5d,0x2c,0x20,0x76,0x73,0x5f,0x70,0x61,0x72,
+    0x61,0x6d,0x73,0x5b,0x32,0x5d,0x2c,0x20,0x76,0x73,0x5f,0x70,0x61,0x72,0x61,0x6d,
+    0x73,0x5b,0x33,0x5d,0x29,0x20,0x2a,0x20,0x76,0x65,0x63,0x34,0x28,0x76,0x65,0x63,
+    0x32,0x28,0x28,0x5f,0x32,0x37,0x2e,0x78,0x20,0x2a,0x20,0x5f,0x31,0x38,0x29,0x20,
+    0x2d,0x20,0x28,0x5f,0x32,0x37,0x2e,0x79,0x20,0x2a,0x20,0x5f,0x31,0x34,0x29,0x2c,
+    0x20,0x28,0x5f,0x32,0x37,0x2e,0x78,0x20,0x2a,0x20,0x5f,0x31,0x34,0x29,0x20,0x2b,
+    0x20,0x28,0x5f,0x32,0x37,0x2e,0x79,0x20,0x2a,0x20,0x5f,0x31,0x38,0x29,0x29,0x20,
+    0x2b,0x20,0x69,0x6e,0x73,0x74,0x5f,0x70,0x6f,0x73,0x2c,0x20,0x30,0x2e,0x30,0x2c,
+    0x20,0x31,0x2e,0x30,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x63,0x6f,0x6c,0x6f,0x72,
+    0x20,0x3d,0x20,0x69,0x6e,0x73,0x74,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x20,
+    0x20,0x20,0x20,0x75,0x76,0x20,0x3d,0x20,0x6d,0x69,0x78,0x28,0x69,0x6e,0x73,0x74,
+    0x5f,0x75,0x76,0x2e,0x78,0x79,0x2c,0x20,0x69,0x6e,0x73,0x74,0x5f,0x75,0x76,0x2e,
+    0x7a,0x77,0x2c,0x20,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x2b,0x20,0x76,
+    0x65,0x63,0x32,0x28,0x30,0x2e,0x35,0x29,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
+};
+//
+// #version 330
+// 
+// uniform sampler2D tex;
+// 
+// in vec2 uv;
+// layout(location = 0) out vec4 frag_color;
+// in vec4 color;
+// 
+// void main()
+// {
+//     frag_color = texture(tex, uv) * color;
+// }
+// 
+//
+const fs_source_glsl330 = [169]u8 {
+    0x23,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x33,0x33,0x30,0x0a,0x0a,0x75,0x6e,
+    0x69,0x66,0x6f,0x72,0x6d,0x20,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x32,0x44,0x20,
+    0x74,0x65,0x78,0x3b,0x0a,0x0a,0x69,0x6e,0x20,0x76,0x65,0x63,0x32,0x20,0x75,0x76,
+    0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,
+    0x6e,0x20,0x3d,0x20,0x30,0x29,0x20,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,0x34,0x20,
+    0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x69,0x6e,0x20,0x76,
+    0x65,0x63,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x0a,0x76,0x6f,0x69,0x64,
+    0x20,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x72,
+    0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x74,0x65,0x78,0x74,0x75,
+    0x72,0x65,0x28,0x74,0x65,0x78,0x2c,0x20,0x75,0x76,0x29,0x20,0x2a,0x20,0x63,0x6f,
+    0x6c,0x6f,0x72,0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
+};
+//
+// cbuffer vs_params : register(b0)
+// {
+//     row_major float4x4 _64_mvp : packoffset(c0);
+// };
+// 
+// 
+// static float4 gl_Position;
+// static float inst_rot;
+// static float2 position;
+// static float2 inst_scale;
+// static float2 inst_pos;
+// static float4 color;
+// static float4 inst_color;
+// static float2 uv;
+// static float4 inst_uv;
+// 
+// struct SPIRV_Cross_Input
+// {
+//     float2 position : TEXCOORD0;
+//     float2 inst_pos : TEXCOORD1;
+//     float2 inst_scale : TEXCOORD2;
+//     float inst_rot : TEXCOORD3;
+//     float4 inst_color : TEXCOORD4;
+//     float4 inst_uv : TEXCOORD5;
+// };
+// 
+// struct SPIRV_Cross_Output
+// {
+//     float4 color : TEXCOORD0;
+//     float2 uv : TEXCOORD1;
+//     float4 gl_Position : SV_Position;
+// };
+// 
+// #line 23 "sprite.glsl"
+// void vert_main()
+// {
+// #line 23 "sprite.glsl"
+//     float _14 = sin(inst_rot);
+// #line 24 "sprite.glsl"
+//     float _18 = cos(inst_rot);
+// #line 25 "sprite.glsl"
+//     float2 _27 = position * inst_scale;
+// #line 27 "sprite.glsl"
+//     gl_Position = mul(float4(float2((_27.x * _18) - (_27.y * _14), (_27.x * _14) + (_27.y * _18)) + inst_pos, 0.0f, 1.0f), _64_mvp);
+// #line 28 "sprite.glsl"
+//     color = inst_color;
+// #line 30 "sprite.glsl"
+//     uv = lerp(inst_uv.xy, inst_uv.zw, position + 0.5f.xx);
+// }
+// 
+// SPIRV_Cross_Output main(SPIRV_Cross_Input stage_input)
+// {
+//     inst_rot = stage_input.inst_rot;
+//     position = stage_input.position;
+//     inst_scale = stage_input.inst_scale;
+//     inst_pos = stage_input.inst_pos;
+//     inst_color = stage_input.inst_color;
+//     inst_uv = stage_input.inst_uv;
+//     vert_main();
+//     SPIRV_Cross_Output stage_output;
+//     stage_output.gl_Position = gl_Position;
+//     stage_output.color = color;
+//     stage_output.uv = uv;
+//     return stage_output;
+// }
+//
+const vs_source_hlsl4 = [1630]u8 {
+    0x63,0x62,0x75,0x66,0x66,0x65,0x72,0x20,0x76,0x73,0x5f,0x70,0x61,0x72,0x61,0x6d,
+    0x73,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,0x28,0x62,0x30,0x29,
+    0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x72,0x6f,0x77,0x5f,0x6d,0x61,0x6a,0x6f,0x72,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x78,0x34,0x20,0x5f,0x36,0x34,0x5f,0x6d,0x76,
+    0x70,0x20,0x3a,0x20,0x70,0x61,0x63,0x6b,0x6f,0x66,0x66,0x73,0x65,0x74,0x28,0x63,
+    0x30,0x29,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,
+    0x6f,0x6e,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x20,0x69,0x6e,0x73,0x74,0x5f,0x72,0x6f,0x74,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,
+    0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,
+    0x6e,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,
+    0x20,0x69,0x6e,0x73,0x74,0x5f,0x73,0x63,0x61,0x6c,0x65,0x3b,0x0a,0x73,0x74,0x61,
+    0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x69,0x6e,0x73,0x74,0x5f,
+    0x70,0x6f,0x73,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,
+    0x74,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x69,0x6e,0x73,0x74,0x5f,0x63,0x6f,0x6c,
+    0x6f,0x72,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x32,0x20,0x75,0x76,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x34,0x20,0x69,0x6e,0x73,0x74,0x5f,0x75,0x76,0x3b,0x0a,0x0a,0x73,0x74,
+    0x72,0x75,0x63,0x74,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,
+    0x5f,0x49,0x6e,0x70,0x75,0x74,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x32,0x20,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3a,0x20,0x54,
+    0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x30,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x32,0x20,0x69,0x6e,0x73,0x74,0x5f,0x70,0x6f,0x73,0x20,0x3a,0x20,
+    0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x32,0x20,0x69,0x6e,0x73,0x74,0x5f,0x73,0x63,0x61,0x6c,0x65,
+    0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x32,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x69,0x6e,0x73,0x74,0x5f,0x72,0x6f,0x74,
+    0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x33,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x69,0x6e,0x73,0x74,0x5f,0x63,0x6f,
+    0x6c,0x6f,0x72,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x34,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x69,0x6e,0x73,0x74,
+    0x5f,0x75,0x76,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x35,0x3b,
+    0x0a,0x7d,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,0x49,0x52,
+    0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x0a,0x7b,
+    0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x63,0x6f,0x6c,0x6f,
+    0x72,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x30,0x3b,0x0a,0x20,
+    0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x75,0x76,0x20,0x3a,0x20,0x54,
+    0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x34,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,
+    0x20,0x3a,0x20,0x53,0x56,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,
+    0x7d,0x3b,0x0a,0x0a,0x23,0x6c,0x69,0x6e,0x65,0x20,0x32,0x33,0x20,0x22,0x73,0x70,
+    0x72,0x69,0x74,0x65,0x2e,0x67,0x6c,0x73,0x6c,0x22,0x0a,0x76,0x6f,0x69,0x64,0x20,
+    0x76,0x65,0x72,0x74,0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x23,0x6c,
+    0x69,0x6e,0x65,0x20,0x32,0x33,0x20,0x22,0x73,0x70,0x72,0x69,0x74,0x65,0x2e,0x67,
+    0x6c,0x73,0x6c,0x22,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x5f,
+    0x31,0x34,0x20,0x3d,0x20,0x73,0x69,0x6e,0x28,0x69,0x6e,0x73,0x74,0x5f,0x72,0x6f,
+    0x74,0x29,0x3b,0x0a,0x23,0x6c,0x69,0x6e,0x65,0x20,0x32,0x34,0x20,0x22,0x73,0x70,
+    0x72,0x69,0x74,0x65,0x2e,0x67,0x6c,0x73,0x6c,0x22,0x0a,0x20,0x20,0x20,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x20,0x5f,0x31,0x38,0x20,0x3d,0x20,0x63,0x6f,0x73,0x28,0x69,
+    0x6e,0x73,0x74,0x5f,0x72,0x6f,0x74,0x29,0x3b,0x0a,0x23,0x6c,0x69,0x6e,0x65,0x20,
+    0x32,0x35,0x20,0x22,0x73,0x70,0x72,0x69,0x74,0x65,0x2e,0x67,0x6c,0x73,0x6c,0x22,
+    0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x5f,0x32,0x37,0x20,
+    0x3d,0x20,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x2a,0x20,0x69,0x6e,0x73,
+    0x74,0x5f,0x73,0x63,0x61,0x6c,0x65,0x3b,0x0a,0x23,0x6c,0x69,0x6e,0x65,0x20,0x32,
+    0x37,0x20,0x22,0x73,0x70,0x72,0x69,0x74,0x65,0x2e,0x67,0x6c,0x73,0x6c,0x22,0x0a,
+    0x20,0x20,0x20,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,
+    0x3d,0x20,0x6d,0x75,0x6c,0x28,0x66,0x6c,0x6f,0x61,0x74,0x34,0x28,0x66,0x6c,0x6f,
+    0x61,0x74,0x32,0x28,0x28,0x5f,0x32,0x37,0x2e,0x78,0x20,0x2a,0x20,0x5f,0x31,0x38,
+    0x29,0x20,0x2d,0x20,0x28,0x5f,0x32,0x37,0x2e,0x79,0x20,0x2a,0x20,0x5f,0x31,0x34,
+    0x29,0x2c,0x20,0x28,0x5f,0x32,0x37,0x2e,0x78,0x20,0x2a,0x20,0x5f,0x31,0x34,0x29,
+    0x20,0x2b,0x20,0x28,0x5f,0x32,0x37,0x2e,0x79,0x20,0x2a,0x20,0x5f,0x31,0x38,0x29,
+    0x29,0x20,0x2b,0x20,0x69,0x6e,0x73,0x74,0x5f,0x70,0x6f,0x73,0x2c,0x20,0x30,0x2e,
+    0x30,0x66,0x2c,0x20,0x31,0x2e,0x30,0x66,0x29,0x2c,0x20,0x5f,0x36,0x34,0x5f,0x6d,
+    0x76,0x70,0x29,0x3b,0x0a,0x23,0x6c,0x69,0x6e,0x65,0x20,0x32,0x38,0x20,0x22,0x73,
+    0x70,0x72,0x69,0x74,0x65,0x2e,0x67,0x6c,0x73,0x6c,0x22,0x0a,0x20,0x20,0x20,0x20,
+    0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x69,0x6e,0x73,0x74,0x5f,0x63,0x6f,0x6c,
+    0x6f,0x72,0x3b,0x0a,0x23,0x6c,0x69,0x6e,0x65,0x20,0x33,0x30,0x20,0x22,0x73,0x70,
+    0x72,0x69,0x74,0x65,0x2e,0x67,0x6c,0x73,0x6c,0x22,0x0a,0x20,0x20,0x20,0x20,0x75,
+    0x76,0x20,0x3d,0x20,0x6c,0x65,0x72,0x70,0x28,0x69,0x6e,0x73,0x74,0x5f,0x75,0x76,
+    0x2e,0x78,0x79,0x2c,0x20,0x69,0x6e,0x73,0x74,0x5f,0x75,0x76,0x2e,0x7a,0x77,0x2c,
+    0x20,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x2b,0x20,0x30,0x2e,0x35,0x66,
+    0x2e,0x78,0x78,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,
+    0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x20,0x6d,0x61,0x69,0x6e,
+    0x28,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,
+    0x75,0x74,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x29,0x0a,
+    0x7b,0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,0x73,0x74,0x5f,0x72,0x6f,0x74,0x20,0x3d,
+    0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x69,0x6e,0x73,
+    0x74,0x5f,0x72,0x6f,0x74,0x3b,0x0a,0x20,0x20,0x20,0x20,0x70,0x6f,0x73,0x69,0x74,
+    0x69,0x6f,0x6e,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,
+    0x74,0x2e,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x69,0x6e,0x73,0x74,0x5f,0x73,0x63,0x61,0x6c,0x65,0x20,0x3d,0x20,0x73,0x74,0x61,
+    0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x69,0x6e,0x73,0x74,0x5f,0x73,0x63,
+    0x61,0x6c,0x65,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,0x73,0x74,0x5f,0x70,0x6f,
+    0x73,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,
+    0x69,0x6e,0x73,0x74,0x5f,0x70,0x6f,0x73,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,
+    0x73,0x74,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,
+    0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x69,0x6e,0x73,0x74,0x5f,0x63,0x6f,0x6c,0x6f,
+    0x72,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,0x73,0x74,0x5f,0x75,0x76,0x20,0x3d,
+    0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x69,0x6e,0x73,
+    0x74,0x5f,0x75,0x76,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x72,0x74,0x5f,0x6d,
+    0x61,0x69,0x6e,0x28,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x53,0x50,0x49,0x52,0x56,
+    0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x20,0x73,0x74,
+    0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x67,0x6c,0x5f,
+    0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x67,0x6c,0x5f,0x50,0x6f,
+    0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x61,0x67,
+    0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,
+    0x20,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x61,0x67,
+    0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x75,0x76,0x20,0x3d,0x20,0x75,0x76,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x73,0x74,0x61,
+    0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,0x0a,0x7d,0x0a,0x00,
+};
+//
+// Texture2D<float4> tex : register(t0);
+// SamplerState _tex_sampler : register(s0);
+// 
+// static float4 frag_color;
+// static float2 uv;
+// static float4 color;
+// 
+// struct SPIRV_Cross_Input
+// {
+//     float4 color : TEXCOORD0;
+//     float2 uv : TEXCOORD1;
+// };
+// 
+// struct SPIRV_Cross_Output
+// {
+//     float4 frag_color : SV_Target0;
+// };
+// 
+// #line 13 "sprite.glsl"
+// void frag_main()
+// {
+// #line 13 "sprite.glsl"
+//     frag_color = tex.Sample(_tex_sampler, uv) * color;
+// }
+// 
+// SPIRV_Cross_Output main(SPIRV_Cross_Input stage_input)
+// {
+//     uv = stage_input.uv;
+//     color = stage_input.color;
+//     frag_main();
+//     SPIRV_Cross_Output stage_output;
+//     stage_output.frag_color = frag_color;
+//     return stage_output;
+// }
+//
+const fs_source_hlsl4 = [663]u8 {
+    0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,0x3c,0x66,0x6c,0x6f,0x61,0x74,0x34,
+    0x3e,0x20,0x74,0x65,0x78,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,
+    0x28,0x74,0x30,0x29,0x3b,0x0a,0x53,0x61,0x6d,0x70,0x6c,0x65,0x72,0x53,0x74,0x61,
+    0x74,0x65,0x20,0x5f,0x74,0x65,0x78,0x5f,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x20,
+    0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,0x28,0x73,0x30,0x29,0x3b,0x0a,
+    0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x66,
+    0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,
+    0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x75,0x76,0x3b,0x0a,0x73,0x74,0x61,
+    0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,
+    0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,
+    0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,0x75,0x74,0x0a,0x7b,0x0a,0x20,0x20,
+    0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3a,
+    0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x30,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x75,0x76,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,
+    0x4f,0x4f,0x52,0x44,0x31,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,
+    0x74,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,
+    0x74,0x70,0x75,0x74,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x34,0x20,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3a,0x20,0x53,
+    0x56,0x5f,0x54,0x61,0x72,0x67,0x65,0x74,0x30,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x23,
+    0x6c,0x69,0x6e,0x65,0x20,0x31,0x33,0x20,0x22,0x73,0x70,0x72,0x69,0x74,0x65,0x2e,
+    0x67,0x6c,0x73,0x6c,0x22,0x0a,0x76,0x6f,0x69,0x64,0x20,0x66,0x72,0x61,0x67,0x5f,
+    0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x23,0x6c,0x69,0x6e,0x65,0x20,0x31,
+    0x33,0x20,0x22,0x73,0x70,0x72,0x69,0x74,0x65,0x2e,0x67,0x6c,0x73,0x6c,0x22,0x0a,
+    0x20,0x20,0x20,0x20,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,
+    0x20,0x74,0x65,0x78,0x2e,0x53,0x61,0x6d,0x70,0x6c,0x65,0x28,0x5f,0x74,0x65,0x78,
+    0x5f,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x2c,0x20,0x75,0x76,0x29,0x20,0x2a,0x20,
+    0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x7d,0x0a,0x0a,0x53,0x50,0x49,0x52,0x56,0x5f,
+    0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x20,0x6d,0x61,0x69,
+    0x6e,0x28,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,
+    0x70,0x75,0x74,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x29,
+    0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x75,0x76,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,
+    0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x75,0x76,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,
+    0x70,0x75,0x74,0x2e,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,
+    0x72,0x61,0x67,0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,
+    0x75,0x74,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,
+    0x74,0x2e,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x66,
+    0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,
+    0x65,0x74,0x75,0x72,0x6e,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,
+    0x75,0x74,0x3b,0x0a,0x7d,0x0a,0x00,
+};
+//
+// #include <metal_stdlib>
+// #include <simd/simd.h>
+// 
+// using namespace metal;
+// 
+// struct vs_params
+// {
+//     float4x4 mvp;
+// };
+// 
+// struct main0_out
+// {
+//     float4 color [[user(locn0)]];
+//     float2 uv [[user(locn1)]];
+//     float4 gl_Position [[position]];
+// };
+// 
+// struct main0_in
+// {
+//     float2 position [[attribute(0)]];
+//     float2 inst_pos [[attribute(1)]];
+//     float2 inst_scale [[attribute(2)]];
+//     float inst_rot [[attribute(3)]];
+//     float4 inst_color [[attribute(4)]];
+//     float4 inst_uv [[attribute(5)]];
+// };
+// 
+// #line 23 "sprite.glsl"
+// vertex main0_out main0(main0_in in [[stage_in]], constant vs_params& _64 [[buffer(0)]])
+// {
+//     main0_out out = {};
+// #line 23 "sprite.glsl"
+//     float _14 = sin(in.inst_rot);
+// #line 24 "sprite.glsl"
+//     float _18 = cos(in.inst_rot);
+// #line 25 "sprite.glsl"
+//     float2 _27 = in.position * in.inst_scale;
+// #line 27 "sprite.glsl"
+//     out.gl_Position = _64.mvp * float4(float2((_27.x * _18) - (_27.y * _14), (_27.x * _14) + (_27.y * _18)) + in.inst_pos, 0.0, 1.0);
+// #line 28 "sprite.glsl"
+//     out.color = in.inst_color;
+// #line 30 "sprite.glsl"
+//     out.uv = mix(in.inst_uv.xy, in.inst_uv.zw, in.position + float2(0.5));
+//     return out;
+// }
+// 
+//
+const vs_source_metal_macos = [1139]u8 {
+    0x23,0x69,0x6e,0x63,0x6c,0x75,0x64,0x65,0x20,0x3c,0x6d,0x65,0x74,0x61,0x6c,0x5f,
+    0x73,0x74,0x64,0x6c,0x69,0x62,0x3e,0x0a,0x23,0x69,0x6e,0x63,0x6c,0x75,0x64,0x65,
+    0x20,0x3c,0x73,0x69,0x6d,0x64,0x2f,0x73,0x69,0x6d,0x64,0x2e,0x68,0x3e,0x0a,0x0a,
+    0x75,0x73,0x69,0x6e,0x67,0x20,0x6e,0x61,0x6d,0x65,0x73,0x70,0x61,0x63,0x65,0x20,
+    0x6d,0x65,0x74,0x61,0x6c,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x76,
+    0x73,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x34,0x78,0x34,0x20,0x6d,0x76,0x70,0x3b,0x0a,0x7d,0x3b,0x0a,
+    0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x6d,0x61,0x69,0x6e,0x30,0x5f,0x6f,0x75,
+    0x74,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x63,
+    0x6f,0x6c,0x6f,0x72,0x20,0x5b,0x5b,0x75,0x73,0x65,0x72,0x28,0x6c,0x6f,0x63,0x6e,
+    0x30,0x29,0x5d,0x5d,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,
+    0x20,0x75,0x76,0x20,0x5b,0x5b,0x75,0x73,0x65,0x72,0x28,0x6c,0x6f,0x63,0x6e,0x31,
+    0x29,0x5d,0x5d,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,
+    0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x5b,0x5b,0x70,0x6f,
+    0x73,0x69,0x74,0x69,0x6f,0x6e,0x5d,0x5d,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x73,0x74,
+    0x72,0x75,0x63,0x74,0x20,0x6d,0x61,0x69,0x6e,0x30,0x5f,0x69,0x6e,0x0a,0x7b,0x0a,
+    0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x70,0x6f,0x73,0x69,0x74,
+    0x69,0x6f,0x6e,0x20,0x5b,0x5b,0x61,0x74,0x74,0x72,0x69,0x62,0x75,0x74,0x65,0x28,
+    0x30,0x29,0x5d,0x5d,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,
+    0x20,0x69,0x6e,0x73,0x74,0x5f,0x70,0x6f,0x73,0x20,0x5b,0x5b,0x61,0x74,0x74,0x72,
+    0x69,0x62,0x75,0x74,0x65,0x28,0x31,0x29,0x5d,0x5d,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x69,0x6e,0x73,0x74,0x5f,0x73,0x63,0x61,0x6c,
+    0x65,0x20,0x5b,0x5b,0x61,0x74,0x74,0x72,0x69,0x62,0x75,0x74,0x65,0x28,0x32,0x29,
+    0x5d,0x5d,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x69,0x6e,
+    0x73,0x74,0x5f,0x72,0x6f,0x74,0x20,0x5b,0x5b,0x61,0x74,0x74,0x72,0x69,0x62,0x75,
+    0x74,0x65,0x28,0x33,0x29,0x5d,0x5d,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x34,0x20,0x69,0x6e,0x73,0x74,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x5b,
+    0x5b,0x61,0x74,0x74,0x72,0x69,0x62,0x75,0x74,0x65,0x28,0x34,0x29,0x5d,0x5d,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x69,0x6e,0x73,0x74,
+    0x5f,0x75,0x76,0x20,0x5b,0x5b,0x61,0x74,0x74,0x72,0x69,0x62,0x75,0x74,0x65,0x28,
+    0x35,0x29,0x5d,0x5d,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x23,0x6c,0x69,0x6e,0x65,0x20,
+    0x32,0x33,0x20,0x22,0x73,0x70,0x72,0x69,0x74,0x65,0x2e,0x67,0x6c,0x73,0x6c,0x22,
+    0x0a,0x76,0x65,0x72,0x74,0x65,0x78,0x20,0x6d,0x61,0x69,0x6e,0x30,0x5f,0x6f,0x75,
+    0x74,0x20,0x6d,0x61,0x69,0x6e,0x30,0x28,0x6d,0x61,0x69,0x6e,0x30,0x5f,0x69,0x6e,
+    0x20,0x69,0x6e,0x20,0x5b,0x5b,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x5d,0x5d,
+    0x2c,0x20,0x63,0x6f,0x6e,0x73,0x74,0x61,0x6e,0x74,0x20,0x76,0x73,0x5f,0x70,0x61,
+    0x72,0x61,0x6d,0x73,0x26,0x20,0x5f,0x36,0x34,0x20,0x5b,0x5b,0x62,0x75,0x66,0x66,
+    0x65,0x72,0x28,0x30,0x29,0x5d,0x5d,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x6d,
+    0x61,0x69,0x6e,0x30,0x5f,0x6f,0x75,0x74,0x20,0x6f,0x75,0x74,0x20,0x3d,0x20,0x7b,
+    0x7d,0x3b,0x0a,0x23,0x6c,0x69,0x6e,0x65,0x20,0x32,0x33,0x20,0x22,0x73,0x70,0x72,
+    0x69,0x74,0x65,0x2e,0x67,0x6c,0x73,0x6c,0x22,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x20,0x5f,0x31,0x34,0x20,0x3d,0x20,0x73,0x69,0x6e,0x28,0x69,0x6e,
+    0x2e,0x69,0x6e,0x73,0x74,0x5f,0x72,0x6f,0x74,0x29,0x3b,0x0a,0x23,0x6c,0x69,0x6e,
+    0x65,0x20,0x32,0x34,0x20,0x22,0x73,0x70,0x72,0x69,0x74,0x65,0x2e,0x67,0x6c,0x73,
+    0x6c,0x22,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x5f,0x31,0x38,
+    0x20,0x3d,0x20,0x63,0x6f,0x73,0x28,0x69,0x6e,0x2e,0x69,0x6e,0x73,0x74,0x5f,0x72,
+    0x6f,0x74,0x29,0x3b,0x0a,0x23,0x6c,0x69,0x6e,0x65,0x20,0x32,0x35,0x20,0x22,0x73,
+    0x70,0x72,0x69,0x74,0x65,0x2e,0x67,0x6c,0x73,0x6c,0x22,0x0a,0x20,0x20,0x20,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x5f,0x32,0x37,0x20,0x3d,0x20,0x69,0x6e,0x2e,
+    0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x2a,0x20,0x69,0x6e,0x2e,0x69,0x6e,
+    0x73,0x74,0x5f,0x73,0x63,0x61,0x6c,0x65,0x3b,0x0a,0x23,0x6c,0x69,0x6e,0x65,0x20,
+    0x32,0x37,0x20,0x22,0x73,0x70,0x72,0x69,0x74,0x65,0x2e,0x67,0x6c,0x73,0x6c,0x22,
+    0x0a,0x20,0x20,0x20,0x20,0x6f,0x75,0x74,0x2e,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,
+    0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x5f,0x36,0x34,0x2e,0x6d,0x76,0x70,0x20,0x2a,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x28,0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,0x28,
+    0x5f,0x32,0x37,0x2e,0x78,0x20,0x2a,0x20,0x5f,0x31,0x38,0x29,0x20,0x2d,0x20,0x28,
+    0x5f,0x32,0x37,0x2e,0x79,0x20,0x2a,0x20,0x5f,0x31,0x34,0x29,0x2c,0x20,0x28,0x5f,
+    0x32,0x37,0x2e,0x78,0x20,0x2a,0x20,0x5f,0x31,0x34,0x29,0x20,0x2b,0x20,0x28,0x5f,
+    0x32,0x37,0x2e,0x79,0x20,0x2a,0x20,0x5f,0x31,0x38,0x29,0x29,0x20,0x2b,0x20,0x69,
+    0x6e,0x2e,0x69,0x6e,0x73,0x74,0x5f,0x70,0x6f,0x73,0x2c,0x20,0x30,0x2e,0x30,0x2c,
+    0x20,0x31,0x2e,0x30,0x29,0x3b,0x0a,0x23,0x6c,0x69,0x6e,0x65,0x20,0x32,0x38,0x20,
+    0x22,0x73,0x70,0x72,0x69,0x74,0x65,0x2e,0x67,0x6c,0x73,0x6c,0x22,0x0a,0x20,0x20,
+    0x20,0x20,0x6f,0x75,0x74,0x2e,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x69,0x6e,
+    0x2e,0x69,0x6e,0x73,0x74,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x23,0x6c,0x69,
+    0x6e,0x65,0x20,0x33,0x30,0x20,0x22,0x73,0x70,0x72,0x69,0x74,0x65,0x2e,0x67,0x6c,
+    0x73,0x6c,0x22,0x0a,0x20,0x20,0x20,0x20,0x6f,0x75,0x74,0x2e,0x75,0x76,0x20,0x3d,
+    0x20,0x6d,0x69,0x78,0x28,0x69,0x6e,0x2e,0x69,0x6e,0x73,0x74,0x5f,0x75,0x76,0x2e,
+    0x78,0x79,0x2c,0x20,0x69,0x6e,0x2e,0x69,0x6e,0x73,0x74,0x5f,0x75,0x76,0x2e,0x7a,
+    0x77,0x2c,0x20,0x69,0x6e,0x2e,0x70,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x2b,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,0x30,0x2e,0x35,0x29,0x29,0x3b,0x0a,0x20,
+    0x20,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x6f,0x75,0x74,0x3b,0x0a,0x7d,
+    0x0a,0x0a,0x00,
+};
+//
+// #include <metal_stdlib>
+// #include <simd/simd.h>
+// 
+// using namespace metal;
+// 
+// struct main0_out
+// {
+//     float4 frag_color [[color(0)]];
+// };
+// 
+// struct main0_in
+// {
+//     float4 color [[user(locn0)]];
+//     float2 uv [[user(locn1)]];
+// };
+// 
+// #line 13 "sprite.glsl"
+// fragment main0_out main0(main0_in in [[stage_in]], texture2d<float> tex [[texture(0)]], sampler texSmplr [[sampler(0)]])
+// {
+//     main0_out out = {};
+// #line 13 "sprite.glsl"
+//     out.frag_color = tex.sample(texSmplr, in.uv) * in.color;
+//     return out;
+// }
+// 
+//
+const fs_source_metal_macos = [492]u8 {
+    0x23,0x69,0x6e,0x63,0x6c,0x75,0x64,0x65,0x20,0x3c,0x6d,0x65,0x74,0x61,0x6c,0x5f,
+    0x73,0x74,0x64,0x6c,0x69,0x62,0x3e,0x0a,0x23,0x69,0x6e,0x63,0x6c,0x75,0x64,0x65,
+    0x20,0x3c,0x73,0x69,0x6d,0x64,0x2f,0x73,0x69,0x6d,0x64,0x2e,0x68,0x3e,0x0a,0x0a,
+    0x75,0x73,0x69,0x6e,0x67,0x20,0x6e,0x61,0x6d,0x65,0x73,0x70,0x61,0x63,0x65,0x20,
+    0x6d,0x65,0x74,0x61,0x6c,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x6d,
+    0x61,0x69,0x6e,0x30,0x5f,0x6f,0x75,0x74,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x34,0x20,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,
+    0x20,0x5b,0x5b,0x63,0x6f,0x6c,0x6f,0x72,0x28,0x30,0x29,0x5d,0x5d,0x3b,0x0a,0x7d,
+    0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x6d,0x61,0x69,0x6e,0x30,0x5f,
+    0x69,0x6e,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,
+    0x63,0x6f,0x6c,0x6f,0x72,0x20,0x5b,0x5b,0x75,0x73,0x65,0x72,0x28,0x6c,0x6f,0x63,
+    0x6e,0x30,0x29,0x5d,0x5d,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x32,0x20,0x75,0x76,0x20,0x5b,0x5b,0x75,0x73,0x65,0x72,0x28,0x6c,0x6f,0x63,0x6e,
+    0x31,0x29,0x5d,0x5d,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x23,0x6c,0x69,0x6e,0x65,0x20,
+    0x31,0x33,0x20,0x22,0x73,0x70,0x72,0x69,0x74,0x65,0x2e,0x67,0x6c,0x73,0x6c,0x22,
+    0x0a,0x66,0x72,0x61,0x67,0x6d,0x65,0x6e,0x74,0x20,0x6d,0x61,0x69,0x6e,0x30,0x5f,
+    0x6f,0x75,0x74,0x20,0x6d,0x61,0x69,0x6e,0x30,0x28,0x6d,0x61,0x69,0x6e,0x30,0x5f,
+    0x69,0x6e,0x20,0x69,0x6e,0x20,0x5b,0x5b,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,
+    0x5d,0x5d,0x2c,0x20,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x64,0x3c,0x66,0x6c,
+    0x6f,0x61,0x74,0x3e,0x20,0x74,0x65,0x78,0x20,0x5b,0x5b,0x74,0x65,0x78,0x74,0x75,
+    0x72,0x65,0x28,0x30,0x29,0x5d,0x5d,0x2c,0x20,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,
+    0x20,0x74,0x65,0x78,0x53,0x6d,0x70,0x6c,0x72,0x20,0x5b,0x5b,0x73,0x61,0x6d,0x70,
+    0x6c,0x65,0x72,0x28,0x30,0x29,0x5d,0x5d,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,
+    0x6d,0x61,0x69,0x6e,0x30,0x5f,0x6f,0x75,0x74,0x20,0x6f,0x75,0x74,0x20,0x3d,0x20,
+    0x7b,0x7d,0x3b,0x0a,0x23,0x6c,0x69,0x6e,0x65,0x20,0x31,0x33,0x20,0x22,0x73,0x70,
+    0x72,0x69,0x74,0x65,0x2e,0x67,0x6c,0x73,0x6c,0x22,0x0a,0x20,0x20,0x20,0x20,0x6f,
+    0x75,0x74,0x2e,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,
+    0x74,0x65,0x78,0x2e,0x73,0x61,0x6d,0x70,0x6c,0x65,0x28,0x74,0x65,0x78,0x53,0x6d,
+    0x70,0x6c,0x72,0x2c,0x20,0x69,0x6e,0x2e,0x75,0x76,0x29,0x20,0x2a,0x20,0x69,0x6e,
+    0x2e,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,0x75,
+    0x72,0x6e,0x20,0x6f,0x75,0x74,0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
+};
+pub fn spriteShaderDesc(backend: sg.Backend) sg.ShaderDesc {
+    var desc: sg.ShaderDesc = .{};
+    switch (backend) {
+        .GLCORE33 => {
+            desc.attrs[0].name = "position";
+            desc.attrs[1].name = "inst_pos";
+            desc.attrs[2].name = "inst_scale";
+            desc.attrs[3].name = "inst_rot";
+            desc.attrs[4].name = "inst_color";
+            desc.attrs[5].name = "inst_uv";
+            desc.vs.source = &vs_source_glsl330;
+            desc.vs.entry = "main";
+            desc.vs.uniform_blocks[0].size = 64;
+            desc.vs.uniform_blocks[0].uniforms[0].name = "vs_params";
+            desc.vs.uniform_blocks[0].uniforms[0].type = .FLOAT4;
+            desc.vs.uniform_blocks[0].uniforms[0].array_count = 4;
+            desc.fs.source = &fs_source_glsl330;
+            desc.fs.entry = "main";
+            desc.fs.images[0].name = "tex";
+            desc.fs.images[0].image_type = ._2D;
+            desc.fs.images[0].sampler_type = .FLOAT;
+            desc.label = "sprite_shader";
+        },
+        .D3D11 => {
+            desc.attrs[0].sem_name = "TEXCOORD";
+            desc.attrs[0].sem_index = 0;
+            desc.attrs[1].sem_name = "TEXCOORD";
+            desc.attrs[1].sem_index = 1;
+            desc.attrs[2].sem_name = "TEXCOORD";
+            desc.attrs[2].sem_index = 2;
+            desc.attrs[3].sem_name = "TEXCOORD";
+            desc.attrs[3].sem_index = 3;
+            desc.attrs[4].sem_name = "TEXCOORD";
+            desc.attrs[4].sem_index = 4;
+            desc.attrs[5].sem_name = "TEXCOORD";
+            desc.attrs[5].sem_index = 5;
+            desc.vs.source = &vs_source_hlsl4;
+            desc.vs.d3d11_target = "vs_4_0";
+            desc.vs.entry = "main";
+            desc.vs.uniform_blocks[0].size = 64;
+            desc.fs.source = &fs_source_hlsl4;
+            desc.fs.d3d11_target = "ps_4_0";
+            desc.fs.entry = "main";
+            desc.fs.images[0].image_type = ._2D;
+            desc.fs.images[0].sampler_type = .FLOAT;
+            desc.label = "sprite_shader";
+        },
+        .METAL_MACOS => {
+            desc.vs.source = &vs_source_metal_macos;
+            desc.vs.entry = "main0";
+            desc.vs.uniform_blocks[0].size = 64;
+            desc.fs.source = &fs_source_metal_macos;
+            desc.fs.entry = "main0";
+            desc.fs.images[0].image_type = ._2D;
+            desc.fs.images[0].sampler_type = .FLOAT;
+            desc.label = "sprite_shader";
+        },
+        else => {},
+    }
+    return desc;
+}
@@ -0,0 +1,464 @@
+//------------------------------------------------------------------------------
+//  snapshot.zig
+//
+//  world snapshots: every entity store is written as contiguous column
+//  blocks next to a small fixed size meta block, so restoring is a mmap and
+//  the columns are used in place
+//
+//  layout, native little endian:
+//      Header (with one StoreRecord per store)
+//      meta block, aligned to block_align
+//      column blocks, each aligned to block_align
+//
+//  saving forks where fork is available: the child writes the file from its
+//  copy-on-write view of the stores while the caller carries on, so the sim
+//  only pays for the fork (page tables, not the columns). Elsewhere the
+//  stores are copied into an in-memory image of the file on the calling
+//  thread and written on a background thread
+//------------------------------------------------------------------------------
+const std = @import("std");
+const os = std.os;
+const mem = std.mem;
+const assert = std.debug.assert;
+const entity = @import("entity.zig");
+const testfiles = @import("testfiles.zig");
+
+comptime {
+    if (std.Target.current.cpu.arch.endian() != .Little) {
+        @compileError("snapshots are little endian");
+    }
+}
+
+pub const magic = [4]u8 { 'L', 'S', 'N', 'P' };
+pub const version: u32 = 1;
+pub const block_align = entity.column_align;
+pub const max_stores = 4;
+pub const max_columns = 16;
+
+pub const Block = extern struct {
+    offset: u64 = 0,
+    size: u64 = 0,
+};
+
+pub const StoreRecord = extern struct {
+    len: u32 = 0,
+    column_count: u32 = 0,
+    columns: [max_columns]Block = [_]Block{.{}} ** max_columns,
+};
+
+pub const Header = extern struct {
+    magic: [4]u8 = magic,
+    version: u32 = version,
+    store_count: u32,
+    reserved: u32 = 0,
+    file_size: u64,
+    meta: Block,
+    stores: [max_stores]StoreRecord = [_]StoreRecord{.{}} ** max_stores,
+};
+
+pub const Error = error {
+    InvalidMagic,
+    InvalidVersion,
+    Truncated,
+    Mismatch, // the snapshot doesn't match the types it is restored into
+};
+
+fn alignBlock(offset: usize) usize {
+    return mem.alignForward(offset, block_align);
+}
+
+const use_fork = std.builtin.os.tag != .windows;
+
+//------------------------------------------------------------------------------
+//  save
+//------------------------------------------------------------------------------
+// a block of the file and where it goes, the header and meta block are
+// followed by every store column
+const Part = struct {
+    offset: u64,
+    bytes: []const u8,
+};
+const max_parts = 2 + max_stores * max_columns;
+
+pub const Saver = struct {
+    allocator: *mem.Allocator,
+    // file image where fork is not available, reused from one save to the next
+    image: ?[]align(block_align) u8 = null,
+    size: usize = 0,
+    path: std.ArrayListUnmanaged(u8) = .{},
+    // writing child where fork is available, reaped by thread
+    child: os.pid_t = undefined,
+    thread: ?*std.Thread = null,
+    done: bool = true,
+    err: ?anyerror = null,
+
+    pub fn init(allocator: *mem.Allocator) Saver {
+        return .{ .allocator = allocator };
+    }
+
+    pub fn deinit(self: *Saver) void {
+        self.wait() catch {};
+        if (self.image) |image| self.allocator.free(image);
+        self.path.deinit(self.allocator);
+        self.* = undefined;
+    }
+
+    pub fn isBusy(self: *const Saver) bool {
+        return !@atomicLoad(bool, &self.done, .Acquire);
+    }
+
+    // captures meta (pointer to an extern struct) and stores (tuple of store
+    // pointers) as they are now and returns, the file is written in the
+    // background. Fails with error.SaveInProgress rather than stalling on the
+    // previous save, a failed previous save is printed and doesn't fail this one
+    pub fn save(self: *Saver, path: []const u8, meta: anytype, stores: anytype) !void {
+        if (self.isBusy()) return error.SaveInProgress;
+        self.wait() catch |err| {
+            std.debug.print("snapshot: previous save failed: {s}\n", .{ @errorName(err) });
+        };
+        comptime assert(stores.len <= max_stores);
+
+        // layout
+        var hdr = Header { .store_count = stores.len, .file_size = 0, .meta = undefined };
+        var offset = alignBlock(@sizeOf(Header));
+        hdr.meta = .{ .offset = offset, .size = @sizeOf(@TypeOf(meta.*)) };
+        offset = alignBlock(offset + hdr.meta.size);
+        inline for (stores) |store, s| {
+            const S = @TypeOf(store.*);
+            comptime assert(S.column_count <= max_columns);
+            const rec = &hdr.stores[s];
+            rec.len = store.len;
+            rec.column_count = S.column_count;
+            for (S.column_sizes) |size, c| {
+                rec.columns[c] = .{ .offset = offset, .size = store.len * size };
+                offset = alignBlock(offset + rec.columns[c].size);
+            }
+        }
+        hdr.file_size = offset;
+
+        // the file, block by block
+        var parts: [max_parts]Part = undefined;
+        parts[0] = .{ .offset = 0, .bytes = mem.asBytes(&hdr) };
+        parts[1] = .{ .offset = hdr.meta.offset, .bytes = mem.asBytes(meta) };
+        var part_count: usize = 2;
+        inline for (stores) |store, s| {
+            const rec = hdr.stores[s];
+            var c: usize = 0;
+            while (c < rec.column_count): (c += 1) {
+                parts[part_count] = .{ .offset = rec.columns[c].offset, .bytes = store.columnBytes(c) };
+                part_count += 1;
+            }
+        }
+
+        self.err = null;
+        if (use_fork) {
+            try self.forkWrite(path, parts[0..part_count], hdr.file_size);
+        }
+        else {
+            try self.copyWrite(path, parts[0..part_count], hdr.file_size);
+        }
+    }
+
+    // the child writes from its copy-on-write view of the caller's memory as
+    // it is now, whatever the caller does to the stores afterwards
+    fn forkWrite(self: *Saver, path: []const u8, parts: []const Part, size: u64) !void {
+        @atomicStore(bool, &self.done, false, .Release);
+        errdefer @atomicStore(bool, &self.done, true, .Release);
+        const pid = try os.fork();
+        if (pid == 0) {
+            // only this thread made it into the child, the locks the others
+            // held stay locked: no allocating or printing from here on
+            writeParts(path, parts, size) catch exitChild(1);
+            exitChild(0);
+        }
+        self.child = pid;
+        self.thread = std.Thread.spawn(reapMain, self) catch |err| {
+            _ = os.waitpid(pid, 0);
+            return err;
+        };
+    }
+
+    // leaves without running the parent's exit handlers or flushing its libc
+    // buffers, the parent owns those
+    fn exitChild(code: u8) noreturn {
+        if (std.builtin.link_libc) std.c._exit(code);
+        os.exit(code);
+    }
+
+    fn reapMain(self: *Saver) void {
+        const status = os.waitpid(self.child, 0);
+        if (!os.WIFEXITED(status) or os.WEXITSTATUS(status) != 0) {
+            self.err = error.SaveFailed;
+        }
+        @atomicStore(bool, &self.done, true, .Release);
+    }
+
+    fn copyWrite(self: *Saver, path: []const u8, parts: []const Part, size: u64) !void {
+        const image_size = @intCast(usize, size);
+        if (self.image == null or self.image.?.len < image_size) {
+            if (self.image) |image| self.allocator.free(image);
+            self.image = null;
+            // some headroom so a growing world doesn't reallocate every save
+            self.image = try self.allocator.allocAdvanced(u8, block_align, image_size + image_size / 4, .exact);
+        }
+        const image = self.image.?;
+        self.size = image_size;
+        for (parts) |part| {
+            copyBlock(image, part.offset, part.bytes);
+        }
+
+        self.path.clearRetainingCapacity();
+        try self.path.appendSlice(self.allocator, path);
+        @atomicStore(bool, &self.done, false, .Release);
+        self.thread = std.Thread.spawn(writeMain, self) catch |err| {
+            @atomicStore(bool, &self.done, true, .Release);
+            return err;
+        };
+    }
+
+    // zeroes the alignment padding too, same world gives the same file
+    fn copyBlock(image: []u8, offset: u64, bytes: []const u8) void {
+        const begin = @intCast(usize, offset);
+        mem.copy(u8, image[begin..], bytes);
+        mem.set(u8, image[begin + bytes.len .. alignBlock(begin + bytes.len)], 0);
+    }
+
+    // joins the last save, returns its error if any
+    pub fn wait(self: *Saver) !void {
+        if (self.thread) |thread| {
+            thread.wait();
+            self.thread = null;
+        }
+        if (self.err) |err| {
+            self.err = null;
+            return err;
+        }
+    }
+
+    fn writeMain(self: *Saver) void {
+        const image = self.image.?[0..self.size];
+        writeParts(self.path.items, &[_]Part{ .{ .offset = 0, .bytes = image } }, image.len) catch |err| {
+            self.err = err;
+        };
+        @atomicStore(bool, &self.done, true, .Release);
+    }
+
+    // written next to the target and renamed, a crash never leaves a torn
+    // file. The padding between parts is zeroed, same world gives the same file
+    fn writeParts(path: []const u8, parts: []const Part, size: u64) !void {
+        var tmpBuf: [std.fs.MAX_PATH_BYTES]u8 = undefined;
+        const tmpPath = try std.fmt.bufPrint(&tmpBuf, "{s}.tmp", .{ path });
+        {
+            const file = try std.fs.cwd().createFile(tmpPath, .{});
+            defer file.close();
+            var pos: u64 = 0;
+            for (parts) |part| {
+                try writeZeros(file, part.offset - pos);
+                try file.writeAll(part.bytes);
+                pos = part.offset + part.bytes.len;
+            }
+            try writeZeros(file, size - pos);
+        }
+        try std.fs.cwd().rename(tmpPath, path);
+    }
+
+    fn writeZeros(file: std.fs.File, count: u64) !void {
+        const zeros = [_]u8{0} ** block_align;
+        var left = count;
+        while (left > 0) {
+            const n = @intCast(usize, std.math.min(left, zeros.len));
+            try file.writeAll(zeros[0..n]);
+            left -= n;
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+//  restore
+//------------------------------------------------------------------------------
+pub const Snapshot = struct {
+    // mapped private and writable: stores restored from it modify their
+    // columns in place, copy-on-write keeps the file untouched
+    bytes: []align(mem.page_size) u8,
+    // only used where mmap is not available
+    allocator: ?*mem.Allocator = null,
+
+    pub fn open(allocator: *mem.Allocator, path: []const u8) !Snapshot {
+        var snap: Snapshot = undefined;
+        if (std.builtin.os.tag == .windows) {
+            const bytes = try std.fs.cwd().readFileAllocOptions(allocator, path, std.math.maxInt(usize), null, mem.page_size, null);
+            snap = .{ .bytes = bytes, .allocator = allocator };
+        }
+        else {
+            const file = try std.fs.cwd().openFile(path, .{});
+            defer file.close();
+            const size = try file.getEndPos();
+            if (size < @sizeOf(Header)) return error.Truncated;
+            const bytes = try os.mmap(null, size, os.PROT_READ | os.PROT_WRITE, os.MAP_PRIVATE, file.handle, 0);
+            snap = .{ .bytes = bytes };
+        }
+        errdefer snap.close();
+        try snap.validate();
+        return snap;
+    }
+
+    // stores restored from the snapshot must be gone (or have grown) by then
+    pub fn close(self: *Snapshot) void {
+        if (self.allocator) |allocator| {
+            allocator.free(self.bytes);
+        }
+        else {
+            os.munmap(self.bytes);
+        }
+        self.* = undefined;
+    }
+
+    fn validBlock(self: Snapshot, block: Block) bool {
+        return block.offset % block_align == 0 and
+            block.size <= self.bytes.len and block.offset <= self.bytes.len - block.size;
+    }
+
+    fn validate(self: Snapshot) Error!void {
+        if (self.bytes.len < @sizeOf(Header)) return error.Truncated;
+        const hdr = self.header();
+        if (!mem.eql(u8, &hdr.magic, &magic)) return error.InvalidMagic;
+        if (hdr.version != version) return error.InvalidVersion;
+        if (hdr.file_size != self.bytes.len) return error.Truncated;
+        if (hdr.store_count > max_stores) return error.Truncated;
+        if (!self.validBlock(hdr.meta)) return error.Truncated;
+        for (hdr.stores[0..hdr.store_count]) |rec| {
+            if (rec.column_count > max_columns) return error.Truncated;
+            for (rec.columns[0..rec.column_count]) |block| {
+                if (!self.validBlock(block)) return error.Truncated;
+            }
+        }
+    }
+
+    pub fn header(self: Snapshot) *const Header {
+        return @ptrCast(*const Header, self.bytes.ptr);
+    }
+
+    pub fn meta(self: Snapshot, comptime M: type) Error!M {
+        const block = self.header().meta;
+        if (block.size != @sizeOf(M)) return error.Mismatch;
+        return mem.bytesToValue(M, self.bytes[block.offset..][0..@sizeOf(M)]);
+    }
+
+    // store number index, its columns stay in the mapping until it grows
+    pub fn store(self: Snapshot, comptime S: type, allocator: *mem.Allocator, index: usize) !S {
+        const hdr = self.header();
+        if (index >= hdr.store_count) return error.Mismatch;
+        const rec = hdr.stores[index];
+        if (rec.column_count != S.column_count) return error.Mismatch;
+
+        var columns: [S.column_count][]align(block_align) u8 = undefined;
+        for (columns) |*column, c| {
+            const block = rec.columns[c];
+            if (block.size != rec.len * S.column_sizes[c]) return error.Mismatch;
+            const offset = @intCast(usize, block.offset);
+            column.* = @alignCast(block_align, self.bytes[offset .. offset + @intCast(usize, block.size)]);
+        }
+        return S.initBorrowed(allocator, columns, rec.len);
+    }
+};
+
+//------------------------------------------------------------------------------
+//  tests
+//------------------------------------------------------------------------------
+const TestMeta = extern struct {
+    tick: u64,
+    zoom: f32,
+};
+
+const TestStore = entity.Store(struct {
+    x: f32,
+    id: u32,
+});
+
+test "Snapshot restores what Saver saved" {
+    var file = try testfiles.TmpFile.init("world.snap");
+    defer file.deinit();
+    const path = file.path;
+
+    var a = TestStore.init(std.testing.allocator);
+    defer a.deinit();
+    var b = TestStore.init(std.testing.allocator);
+    defer b.deinit();
+    var i: u32 = 0;
+    while (i < 100): (i += 1) {
+        _ = try a.create(.{ .x = @intToFloat(f32, i), .id = i });
+        if (i % 3 == 0) _ = try b.create(.{ .x = -1.0, .id = i * 2 });
+    }
+    const meta = TestMeta { .tick = 1234, .zoom = 0.5 };
+
+    var saver = Saver.init(std.testing.allocator);
+    defer saver.deinit();
+    try saver.save(path, &meta, .{ &a, &b });
+    // changes after save returns don't make it into the file
+    a.items(.x)[0] = -5.0;
+    try saver.wait();
+    a.items(.x)[0] = 0.0;
+
+    var snap = try Snapshot.open(std.testing.allocator, path);
+    defer snap.close();
+    const back = try snap.meta(TestMeta);
+    assert(back.tick == meta.tick and back.zoom == meta.zoom);
+    for ([_]*TestStore{ &a, &b }) |store, s| {
+        var restored = try snap.store(TestStore, std.testing.allocator, s);
+        defer restored.deinit();
+        assert(restored.len == store.len);
+        var c: usize = 0;
+        while (c < TestStore.column_count): (c += 1) {
+            assert(mem.eql(u8, restored.columnBytes(c), store.columnBytes(c)));
+        }
+    }
+}
+
+// an empty meta block and no store
+const test_file_size = alignBlock(@sizeOf(Header)) + block_align;
+const test_header = Header {
+    .store_count = 0,
+    .file_size = test_file_size,
+    .meta = .{ .offset = alignBlock(@sizeOf(Header)), .size = block_align },
+};
+
+// the first len bytes of a file starting with hdr
+fn writeTestFile(file: testfiles.TmpFile, hdr: Header, len: usize) !void {
+    var bytes align(block_align) = [_]u8{0} ** test_file_size;
+    mem.copy(u8, &bytes, mem.asBytes(&hdr));
+    try file.write(bytes[0..len]);
+}
+
+test "Snapshot.open rejects malformed files" {
+    var file = try testfiles.TmpFile.init("test.snap");
+    defer file.deinit();
+
+    // well formed to start with
+    try writeTestFile(file, test_header, test_file_size);
+    var snap = try Snapshot.open(std.testing.allocator, file.path);
+    snap.close();
+
+    var hdr = test_header;
+    hdr.magic[0] = 'X';
+    try writeTestFile(file, hdr, test_file_size);
+    try testfiles.expectOpenError(Snapshot, error.InvalidMagic, file.path);
+
+    hdr = test_header;
+    hdr.version = version + 1;
+    try writeTestFile(file, hdr, test_file_size);
+    try testfiles.expectOpenError(Snapshot, error.InvalidVersion, file.path);
+
+    // shorter than the header says, then shorter than the header itself
+    try writeTestFile(file, test_header, test_file_size - block_align);
+    try testfiles.expectOpenError(Snapshot, error.Truncated, file.path);
+    try writeTestFile(file, test_header, @sizeOf(Header) / 2);
+    try testfiles.expectOpenError(Snapshot, error.Truncated, file.path);
+
+    // a column past the end whose offset + size wraps around into the file
+    hdr = test_header;
+    hdr.store_count = 1;
+    hdr.stores[0].column_count = 1;
+    hdr.stores[0].columns[0] = .{ .offset = std.math.maxInt(u64) - block_align + 1, .size = 2 * block_align };
+    try writeTestFile(file, hdr, test_file_size);
+    try testfiles.expectOpenError(Snapshot, error.Truncated, file.path);
+}
@@ -1,6 +1,12 @@
 #define SOKOL_ZIG_BINDINGS
 #define SOKOL_NO_ENTRY
-#if defined(_WIN32)
+// zones inside sokol_gfx show up in the profiler, see prof.zig
+#include "../../prof.h"
+#define SOKOL_PROF_BEGIN(name) prof_begin(name)
+#define SOKOL_PROF_END() prof_end()
+#if defined(SOKOL_DUMMY_BACKEND)
+    // no window and no GPU, see sokol_headless.c
+#elif defined(_WIN32)
     #define SOKOL_WIN32_FORCE_MAIN
     #define SOKOL_D3D11
     #define SOKOL_LOG(msg) OutputDebugStringA(msg)
@@ -283,6 +283,17 @@
         to sokol_gfx.h internals, and may change more often than other
         public API functions and structs.
 
+    --- the resource pools start out with the sizes in sg_desc and grow
+        on demand, you can check how big they got and how often they had
+        to grow with:
+
+            sg_pool_stats sg_query_pool_stats(void)
+
+    --- to see where the time of a frame went (call count, state changes
+        or upload bandwidth), get the counters of the last committed frame:
+
+            sg_frame_stats sg_query_frame_stats(void)
+
     --- you can ask at runtime what backend sokol_gfx.h has been compiled
         for, or whether the GLES3 backend had to fall back to GLES2 with:
 
@@ -1726,6 +1737,18 @@ typedef struct sg_image_desc {
     For all GL backends, shader source-code must be provided. For D3D11 and Metal,
     either shader source-code or byte-code can be provided.
 
+    With SOKOL_GLCORE33, a uniform block whose first member lives inside a
+    GLSL uniform block is bound as uniform buffer range with the content of
+    sg_apply_uniforms() copied verbatim, so the GLSL block must be declared
+    layout(std140) with the same layout as the C struct (vec4 and mat4
+    members, or arrays of them, always match), for instance:
+
+        layout(std140) uniform vs_params_block {
+            vec4 vs_params[8];
+        };
+
+    Uniforms outside of GLSL uniform blocks are set with glUniform*() calls.
+
     For D3D11, if source code is provided, the d3dcompiler_47.dll will be loaded
     on demand. If this fails, shader creation will fail. When compiling HLSL
     source code, you can provide an optional target string via
@@ -2095,6 +2118,78 @@ typedef struct sg_pass_info {
     sg_slot_info slot;              /* resource pool slot info */
 } sg_pass_info;
 
+/*
+    sg_pool_info
+    sg_pool_stats
+
+    Returned by sg_query_pool_stats(). A pool that runs out of free slots
+    allocates another chunk as big as the whole pool so far (up to 65535
+    resources), existing resources never move. Each such growth bumps the
+    grow_count of the pool, if it keeps growing after startup consider
+    raising its initial size in sg_desc.
+*/
+typedef struct sg_pool_info {
+    int capacity;       /* number of resources the pool can currently hold */
+    int num_used;       /* number of allocated slots */
+    int grow_count;     /* number of times the pool had to grow */
+} sg_pool_info;
+
+typedef struct sg_pool_stats {
+    sg_pool_info buffers;
+    sg_pool_info images;
+    sg_pool_info shaders;
+    sg_pool_info pipelines;
+    sg_pool_info passes;
+    sg_pool_info contexts;
+} sg_pool_stats;
+
+/*
+    sg_frame_stats
+
+    Returned by sg_query_frame_stats(), these are the counters of the
+    frame which was finished by the last sg_commit(). Calls that were
+    dropped by validation or because of an invalid pass are not counted.
+
+    The gl member is only filled by the GL backends, the num_* items count
+    the GL calls which were actually issued, the num_redundant_* items the
+    calls the GL state cache filtered out because the state was already set.
+*/
+typedef struct sg_frame_stats_gl {
+    uint32_t num_use_program;
+    uint32_t num_bind_buffer;
+    uint32_t num_bind_texture;
+    uint32_t num_vertex_attrib_pointer;
+    uint32_t num_enable_vertex_attrib_array;
+    uint32_t num_disable_vertex_attrib_array;
+    uint32_t num_uniform;                       /* glUniform*() calls */
+    uint32_t num_bind_uniform_buffer;           /* glBindBufferRange() calls for std140 uniform blocks */
+    uint32_t num_bind_vertex_array;
+    uint32_t num_vertex_array_cache_miss;       /* VAOs built by sg_apply_bindings() */
+    uint32_t num_redundant_pipeline;            /* sg_apply_pipeline() with the current pipeline */
+    uint32_t num_redundant_bind_buffer;
+    uint32_t num_redundant_bind_texture;
+    uint32_t num_redundant_vertex_attrib;       /* vertex attributes already pointing at the right place */
+} sg_frame_stats_gl;
+
+typedef struct sg_frame_stats {
+    uint32_t frame_index;           /* the frame these counters belong to */
+    uint32_t num_passes;
+    uint32_t num_apply_pipeline;
+    uint32_t num_apply_bindings;
+    uint32_t num_apply_uniforms;
+    uint32_t num_draw;
+    uint32_t num_instances;         /* summed over all draw calls */
+    uint32_t num_vertices;          /* elements times instances summed over all draw calls */
+    uint32_t num_update_buffer;
+    uint32_t num_append_buffer;
+    uint32_t num_update_image;
+    uint32_t size_apply_uniforms;   /* bytes */
+    uint32_t size_update_buffer;
+    uint32_t size_append_buffer;
+    uint32_t size_update_image;
+    sg_frame_stats_gl gl;
+} sg_frame_stats;
+
 /*
     sg_desc
 
@@ -2108,6 +2203,9 @@ typedef struct sg_pass_info {
 
     FIXME: explain the various configuration options
 
+    The *_pool_size items are the initial pool sizes, pools double in
+    size whenever they run out of slots (see sg_query_pool_stats()).
+
     The default configuration is:
 
     .buffer_pool_size       128
@@ -2132,6 +2230,34 @@ typedef struct sg_pass_info {
             if this is true the GL backend will act in "GLES2 fallback mode" even
             when compiled with SOKOL_GLES3, this is useful to fall back
             to traditional WebGL if a browser doesn't support a WebGL2 context
+        .context.gl.vao_cache_size (default: 64)
+            the number of vertex array objects a context keeps around (not used
+            with GLES2). sg_apply_bindings() with a pipeline and a set of vertex
+            buffers, buffer offsets and index buffer seen before binds the VAO
+            it built for them with a single glBindVertexArray(), the least
+            recently used VAO makes room for a new combination. Bindings with
+            SG_USAGE_STREAM buffers change every frame and keep going through
+            the context's own VAO.
+        .staging_buffer_size
+            with SOKOL_GLCORE33 on a GL 4.4 context (or GL_ARB_buffer_storage),
+            the size of one persistently mapped ring which holds the content of
+            all SG_USAGE_STREAM buffers, sg_update_buffer() and sg_append_buffer()
+            become a memcpy into mapped memory. The first sg_append_buffer() of a
+            frame reserves the whole buffer size in the ring, frames are fenced
+            and the ring only waits when the CPU gets a whole ring ahead of the
+            GPU. Buffers which don't fit take the glBufferSubData() path, so
+            size the ring for the STREAM buffers of about three frames. The
+            content of a STREAM buffer only lives for the frame it was written
+            in: bind a STREAM buffer only in frames which update or append to
+            it (DYNAMIC buffers keep their content).
+        .uniform_buffer_size
+            with SOKOL_GLCORE33, the size of the buffer which feeds the uniform
+            blocks the GLSL code declares as std140 blocks (see sg_shader_desc),
+            persistently mapped and fenced per frame like the staging ring when
+            the context has buffer storage, otherwise (and for the uniforms of a
+            frame which overruns the ring) filled with glBufferSubData() and
+            orphaned when it runs full. Each sg_apply_uniforms() takes the
+            block size rounded up to GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
 
     Metal specific:
         (NOTE: All Objective-C object references are transferred through
@@ -2208,6 +2334,7 @@ typedef struct sg_pass_info {
 */
 typedef struct sg_gl_context_desc {
     bool force_gles2;
+    int vao_cache_size;
 } sg_gl_context_desc;
 
 typedef struct sg_metal_context_desc {
@@ -2323,6 +2450,10 @@ SOKOL_GFX_API_DECL sg_image_info sg_query_image_info(sg_image img);
 SOKOL_GFX_API_DECL sg_shader_info sg_query_shader_info(sg_shader shd);
 SOKOL_GFX_API_DECL sg_pipeline_info sg_query_pipeline_info(sg_pipeline pip);
 SOKOL_GFX_API_DECL sg_pass_info sg_query_pass_info(sg_pass pass);
+/* get resource pool sizes and growth counters */
+SOKOL_GFX_API_DECL sg_pool_stats sg_query_pool_stats(void);
+/* get the counters of the last committed frame */
+SOKOL_GFX_API_DECL sg_frame_stats sg_query_frame_stats(void);
 /* get resource creation desc struct with their default values replaced */
 SOKOL_GFX_API_DECL sg_buffer_desc sg_query_buffer_defaults(const sg_buffer_desc* desc);
 SOKOL_GFX_API_DECL sg_image_desc sg_query_image_defaults(const sg_image_desc* desc);
@@ -2460,6 +2591,13 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
         #define SOKOL_LOG(s)
     #endif
 #endif
+/* optional profiler zones around the expensive calls, (name) is a string literal */
+#ifndef SOKOL_PROF_BEGIN
+    #define SOKOL_PROF_BEGIN(name)
+#endif
+#ifndef SOKOL_PROF_END
+    #define SOKOL_PROF_END()
+#endif
 
 #ifndef _SOKOL_PRIVATE
     #if defined(__GNUC__) || defined(__clang__)
@@ -2699,6 +2837,7 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
         #define GL_FRAGMENT_SHADER 0x8B30
         #define GL_FLOAT 0x1406
         #define GL_TEXTURE_MAX_LOD 0x813B
+        #define GL_TEXTURE_MAX_LEVEL 0x813D
         #define GL_DEPTH_COMPONENT 0x1902
         #define GL_ONE_MINUS_DST_ALPHA 0x0305
         #define GL_COLOR 0x1800
@@ -2918,6 +3057,56 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
     #ifndef GL_LUMINANCE
     #define GL_LUMINANCE 0x1909
     #endif
+    #ifndef GL_MAJOR_VERSION
+    #define GL_MAJOR_VERSION 0x821B
+    #endif
+    #ifndef GL_MINOR_VERSION
+    #define GL_MINOR_VERSION 0x821C
+    #endif
+    #ifndef GL_MAP_WRITE_BIT
+    #define GL_MAP_WRITE_BIT 0x0002
+    #endif
+    #ifndef GL_MAP_PERSISTENT_BIT
+    #define GL_MAP_PERSISTENT_BIT 0x0040
+    #endif
+    #ifndef GL_MAP_COHERENT_BIT
+    #define GL_MAP_COHERENT_BIT 0x0080
+    #endif
+    #ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+    #endif
+    #ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+    #endif
+    #ifndef GL_TIMEOUT_EXPIRED
+    #define GL_TIMEOUT_EXPIRED 0x911B
+    #endif
+    #ifndef GL_WAIT_FAILED
+    #define GL_WAIT_FAILED 0x911D
+    #endif
+    #ifndef GL_UNIFORM_BUFFER
+    #define GL_UNIFORM_BUFFER 0x8A11
+    #endif
+    #ifndef GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+    #define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+    #endif
+    #ifndef GL_UNIFORM_BLOCK_INDEX
+    #define GL_UNIFORM_BLOCK_INDEX 0x8A3A
+    #endif
+    #ifndef GL_UNIFORM_BLOCK_DATA_SIZE
+    #define GL_UNIFORM_BLOCK_DATA_SIZE 0x8A40
+    #endif
+    #ifndef GL_INVALID_INDEX
+    #define GL_INVALID_INDEX 0xFFFFFFFFu
+    #endif
+
+    /* STREAM buffers live in a persistently mapped ring when the context
+       has buffer storage (GL 4.4 or GL_ARB_buffer_storage), the GL headers
+       on macOS stop at GL 4.1
+    */
+    #if defined(SOKOL_GLCORE33) && !defined(__APPLE__)
+        #define _SOKOL_GL_STREAM_RING (1)
+    #endif
 
     #ifdef SOKOL_GLES2
         #ifdef GL_ANGLE_instanced_arrays
@@ -2957,6 +3146,7 @@ enum {
     _SG_SLOT_SHIFT = 16,
     _SG_SLOT_MASK = (1<<_SG_SLOT_SHIFT)-1,
     _SG_MAX_POOL_SIZE = (1<<_SG_SLOT_SHIFT),
+    _SG_MAX_POOL_CHUNKS = _SG_SLOT_SHIFT + 1,   /* pools start with at least 2 slots and double on growth */
     _SG_DEFAULT_BUFFER_POOL_SIZE = 128,
     _SG_DEFAULT_IMAGE_POOL_SIZE = 128,
     _SG_DEFAULT_SHADER_POOL_SIZE = 32,
@@ -2964,6 +3154,7 @@ enum {
     _SG_DEFAULT_PASS_POOL_SIZE = 16,
     _SG_DEFAULT_CONTEXT_POOL_SIZE = 16,
     _SG_DEFAULT_SAMPLER_CACHE_CAPACITY = 64,
+    _SG_DEFAULT_VAO_CACHE_SIZE = 64,
     _SG_DEFAULT_UB_SIZE = 4 * 1024 * 1024,
     _SG_DEFAULT_STAGING_SIZE = 8 * 1024 * 1024,
 };
@@ -3317,6 +3508,8 @@ typedef struct {
     struct {
         GLuint buf[SG_NUM_INFLIGHT_FRAMES];
         bool ext_buffers;   /* if true, external buffers were injected with sg_buffer_desc.gl_buffers */
+        bool in_ring;       /* if true, the current content lives in the stream ring at ring_offset */
+        int ring_offset;
     } gl;
 } _sg_gl_buffer_t;
 typedef _sg_gl_buffer_t _sg_buffer_t;
@@ -3344,6 +3537,7 @@ typedef struct {
 typedef struct {
     int num_uniforms;
     _sg_gl_uniform_t uniforms[SG_MAX_UB_MEMBERS];
+    int gl_size;    /* > 0 if the GLSL code declares the block as std140 uniform block */
 } _sg_gl_uniform_block_t;
 
 typedef struct {
@@ -3416,10 +3610,30 @@ typedef struct {
 typedef _sg_gl_pass_t _sg_pass_t;
 typedef _sg_pass_attachment_common_t _sg_pass_attachment_t;
 
+#if !defined(SOKOL_GLES2)
+/* what a VAO captures: the vertex layout of the pipeline and the bound buffers */
+typedef struct {
+    uint32_t pip_id;
+    GLuint ib;
+    GLuint vbs[SG_MAX_SHADERSTAGE_BUFFERS];
+    int vb_offsets[SG_MAX_SHADERSTAGE_BUFFERS];
+} _sg_gl_vao_key_t;
+
+typedef struct {
+    _sg_gl_vao_key_t key;
+    uint32_t hash;
+    uint32_t last_use;
+    GLuint vao;     /* 0 if the item is free */
+} _sg_gl_vao_cache_item_t;
+#endif
+
 typedef struct {
     _sg_slot_t slot;
     #if !defined(SOKOL_GLES2)
     GLuint vao;
+    int vao_cache_size;
+    uint32_t vao_cache_tick;
+    _sg_gl_vao_cache_item_t* vao_cache;
     #endif
     GLuint default_framebuffer;
 } _sg_gl_context_t;
@@ -3451,6 +3665,8 @@ typedef struct {
     GLuint index_buffer;
     GLuint stored_vertex_buffer;
     GLuint stored_index_buffer;
+    GLuint cur_vao;
+    GLuint default_vao_index_buffer;    /* the index buffer of the context's VAO while a cached one is bound */
     GLuint prog;
     _sg_gl_texture_bind_slot textures[SG_MAX_SHADERSTAGE_IMAGES];
     _sg_gl_texture_bind_slot stored_texture;
@@ -3462,6 +3678,57 @@ typedef struct {
     sg_pipeline cur_pipeline_id;
 } _sg_gl_state_cache_t;
 
+#if defined(_SOKOL_GL_STREAM_RING)
+enum {
+    _SG_GL_RING_ALIGN = 256,
+    _SG_GL_RING_MAX_FRAMES = SG_NUM_INFLIGHT_FRAMES + 1,
+};
+
+typedef struct {
+    GLsync fence;
+    int end;        /* ring position behind the last allocation of the frame */
+    int used;       /* bytes held by the frame, including padding skipped on wrap-around */
+} _sg_gl_ring_frame_t;
+
+/*  one persistently mapped, coherent buffer shared by all STREAM buffers
+    (the uniform ring below is another one), allocations of the current frame go to head, the frames the GPU may
+    still read from sit between tail and head, each behind a fence
+*/
+typedef struct {
+    bool valid;
+    GLuint buf;
+    uint8_t* ptr;
+    int align;
+    int size;
+    int head;
+    int tail;
+    int used;
+    int frame_used;
+    int first_frame;
+    int num_frames;
+    _sg_gl_ring_frame_t frames[_SG_GL_RING_MAX_FRAMES];
+} _sg_gl_stream_ring_t;
+#endif
+
+#if defined(SOKOL_GLCORE33)
+/*  the std140 uniform blocks of all shaders are fed from one buffer, every
+    sg_apply_uniforms() takes the next aligned range: a persistently mapped
+    ring fenced per frame like the stream ring when the context has buffer
+    storage, otherwise (or when a frame overruns the ring) a buffer filled
+    with glBufferSubData() and orphaned whenever it runs full
+*/
+typedef struct {
+    bool valid;
+    int align;          /* GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT */
+    #if defined(_SOKOL_GL_STREAM_RING)
+    _sg_gl_stream_ring_t ring;
+    #endif
+    GLuint buf;
+    int size;
+    int offset;
+} _sg_gl_uniform_ring_t;
+#endif
+
 typedef struct {
     bool valid;
     bool gles2;
@@ -3472,7 +3739,14 @@ typedef struct {
     _sg_pass_t* cur_pass;
     sg_pass cur_pass_id;
     _sg_gl_state_cache_t cache;
+    #if defined(_SOKOL_GL_STREAM_RING)
+    _sg_gl_stream_ring_t ring;
+    #endif
+    #if defined(SOKOL_GLCORE33)
+    _sg_gl_uniform_ring_t ub_ring;
+    #endif
     bool ext_anisotropic;
+    bool ext_buffer_storage;
     GLint max_anisotropy;
     GLint max_combined_texture_image_units;
     #if _SOKOL_USE_WIN32_GL_LOADER
@@ -3878,11 +4152,21 @@ typedef struct {
 /* this *MUST* remain 0 */
 #define _SG_INVALID_SLOT_INDEX (0)
 
+/*  pool items live in chunks which are never moved or freed before
+    shutdown, an exhausted pool appends a new chunk as big as the whole
+    pool so far, this keeps resource ids and item pointers valid while
+    the pool grows up to _SG_MAX_POOL_SIZE
+*/
 typedef struct {
     int size;
     int queue_top;
     uint32_t* gen_ctrs;
     int* free_queue;
+    size_t item_size;
+    int num_chunks;
+    int chunk_start[_SG_MAX_POOL_CHUNKS];   /* slot index of the first item in each chunk */
+    uint8_t* chunks[_SG_MAX_POOL_CHUNKS];
+    int grow_count;
 } _sg_pool_t;
 
 typedef struct {
@@ -3892,12 +4176,6 @@ typedef struct {
     _sg_pool_t pipeline_pool;
     _sg_pool_t pass_pool;
     _sg_pool_t context_pool;
-    _sg_buffer_t* buffers;
-    _sg_image_t* images;
-    _sg_shader_t* shaders;
-    _sg_pipeline_t* pipelines;
-    _sg_pass_t* passes;
-    _sg_context_t* contexts;
 } _sg_pools_t;
 
 /*=== VALIDATION LAYER DECLARATIONS ==========================================*/
@@ -4040,6 +4318,8 @@ typedef struct {
     _sg_validate_error_t validate_error;
     #endif
     _sg_pools_t pools;
+    sg_frame_stats stats;           /* counters of the current frame */
+    sg_frame_stats prev_stats;      /* counters of the last committed frame */
     sg_backend backend;
     sg_features features;
     sg_limits limits;
@@ -4753,16 +5033,32 @@ _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data
     _SG_XMACRO(glTexImage2D,                      void, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void * pixels)) \
     _SG_XMACRO(glGenVertexArrays,                 void, (GLsizei n, GLuint * arrays)) \
     _SG_XMACRO(glFrontFace,                       void, (GLenum mode)) \
-    _SG_XMACRO(glCullFace,                        void, (GLenum mode))
+    _SG_XMACRO(glCullFace,                        void, (GLenum mode)) \
+    _SG_XMACRO(glMapBufferRange,                  void*, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)) \
+    _SG_XMACRO(glUnmapBuffer,                     GLboolean, (GLenum target)) \
+    _SG_XMACRO(glFenceSync,                       GLsync, (GLenum condition, GLbitfield flags)) \
+    _SG_XMACRO(glClientWaitSync,                  GLenum, (GLsync sync, GLbitfield flags, GLuint64 timeout)) \
+    _SG_XMACRO(glDeleteSync,                      void, (GLsync sync)) \
+    _SG_XMACRO(glBindBufferRange,                 void, (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)) \
+    _SG_XMACRO(glGetUniformIndices,               void, (GLuint program, GLsizei uniformCount, const GLchar *const* uniformNames, GLuint * uniformIndices)) \
+    _SG_XMACRO(glGetActiveUniformsiv,             void, (GLuint program, GLsizei uniformCount, const GLuint * uniformIndices, GLenum pname, GLint * params)) \
+    _SG_XMACRO(glGetActiveUniformBlockiv,         void, (GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint * params)) \
+    _SG_XMACRO(glUniformBlockBinding,             void, (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding))
+
+// GL functions newer than GL 3.3, these may be missing and must be checked before use
+#define _SG_GL_OPTIONAL_FUNCS \
+    _SG_XMACRO(glBufferStorage,                   void, (GLenum target, GLsizeiptr size, const void * data, GLbitfield flags))
 
 // generate GL function pointer typedefs
 #define _SG_XMACRO(name, ret, args) typedef ret (GL_APIENTRY* PFN_ ## name) args;
 _SG_GL_FUNCS
+_SG_GL_OPTIONAL_FUNCS
 #undef _SG_XMACRO
 
 // generate GL function pointers
 #define _SG_XMACRO(name, ret, args) static PFN_ ## name name;
 _SG_GL_FUNCS
+_SG_GL_OPTIONAL_FUNCS
 #undef _SG_XMACRO
 
 // helper function to lookup GL functions in GL DLL
@@ -4772,7 +5068,6 @@ _SOKOL_PRIVATE void* _sg_gl_getprocaddr(const char* name, _sg_wglGetProcAddress
     if (0 == proc_addr) {
         proc_addr = (void*) GetProcAddress(_sg.gl.opengl32_dll, name);
     }
-    SOKOL_ASSERT(proc_addr);
     return proc_addr;
 }
 
@@ -4783,9 +5078,12 @@ _SOKOL_PRIVATE  void _sg_gl_load_opengl(void) {
     SOKOL_ASSERT(_sg.gl.opengl32_dll);
     _sg_wglGetProcAddress wgl_getprocaddress = (_sg_wglGetProcAddress) GetProcAddress(_sg.gl.opengl32_dll, "wglGetProcAddress");
     SOKOL_ASSERT(wgl_getprocaddress);
-    #define _SG_XMACRO(name, ret, args) name = (PFN_ ## name) _sg_gl_getprocaddr(#name, wgl_getprocaddress);
+    #define _SG_XMACRO(name, ret, args) name = (PFN_ ## name) _sg_gl_getprocaddr(#name, wgl_getprocaddress); SOKOL_ASSERT(name);
     _SG_GL_FUNCS
     #undef _SG_XMACRO
+    #define _SG_XMACRO(name, ret, args) name = (PFN_ ## name) _sg_gl_getprocaddr(#name, wgl_getprocaddress);
+    _SG_GL_OPTIONAL_FUNCS
+    #undef _SG_XMACRO
 }
 
 _SOKOL_PRIVATE void _sg_gl_unload_opengl(void) {
@@ -5579,8 +5877,19 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_glcore33(void) {
             else if (strstr(ext, "_texture_filter_anisotropic")) {
                 _sg.gl.ext_anisotropic = true;
             }
+            else if (strstr(ext, "_buffer_storage")) {
+                _sg.gl.ext_buffer_storage = true;
+            }
         }
     }
+    /* buffer storage is core since GL 4.4 */
+    GLint major_version = 0;
+    GLint minor_version = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major_version);
+    glGetIntegerv(GL_MINOR_VERSION, &minor_version);
+    if ((major_version > 4) || ((major_version == 4) && (minor_version >= 4))) {
+        _sg.gl.ext_buffer_storage = true;
+    }
 
     /* limits */
     _sg_gl_init_limits();
@@ -5815,17 +6124,14 @@ _SOKOL_PRIVATE void _sg_gl_cache_clear_buffer_bindings(bool force) {
 
 _SOKOL_PRIVATE void _sg_gl_cache_bind_buffer(GLenum target, GLuint buffer) {
     SOKOL_ASSERT((GL_ARRAY_BUFFER == target) || (GL_ELEMENT_ARRAY_BUFFER == target));
-    if (target == GL_ARRAY_BUFFER) {
-        if (_sg.gl.cache.vertex_buffer != buffer) {
-            _sg.gl.cache.vertex_buffer = buffer;
-            glBindBuffer(target, buffer);
-        }
+    GLuint* cache_buffer = (target == GL_ARRAY_BUFFER) ? &_sg.gl.cache.vertex_buffer : &_sg.gl.cache.index_buffer;
+    if (*cache_buffer != buffer) {
+        *cache_buffer = buffer;
+        glBindBuffer(target, buffer);
+        _sg.stats.gl.num_bind_buffer++;
     }
     else {
-        if (_sg.gl.cache.index_buffer != buffer) {
-            _sg.gl.cache.index_buffer = buffer;
-            glBindBuffer(target, buffer);
-        }
+        _sg.stats.gl.num_redundant_bind_buffer++;
     }
 }
 
@@ -5871,6 +6177,9 @@ _SOKOL_PRIVATE void _sg_gl_cache_invalidate_buffer(GLuint buf) {
     if (buf == _sg.gl.cache.stored_index_buffer) {
         _sg.gl.cache.stored_index_buffer = 0;
     }
+    if (buf == _sg.gl.cache.default_vao_index_buffer) {
+        _sg.gl.cache.default_vao_index_buffer = 0;
+    }
     for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
         if (buf == _sg.gl.cache.attrs[i].gl_vbuf) {
             _sg.gl.cache.attrs[i].gl_vbuf = 0;
@@ -5878,6 +6187,191 @@ _SOKOL_PRIVATE void _sg_gl_cache_invalidate_buffer(GLuint buf) {
     }
 }
 
+#if !defined(SOKOL_GLES2)
+/*-- vertex array cache --------------------------------------------------------
+
+    Each context keeps a small LRU cache of VAOs, one per combination of
+    pipeline, vertex buffers, vertex buffer offsets and index buffer passed
+    to sg_apply_bindings(). The attribute part of the state cache and the
+    non-cached path only ever talk about the context's own VAO, the element
+    array buffer binding is VAO state though, so the state cache's index
+    buffer follows whichever VAO is bound.
+*/
+_SOKOL_PRIVATE void _sg_gl_vao_cache_init(_sg_context_t* ctx, int size) {
+    SOKOL_ASSERT(ctx && (size > 0) && (0 == ctx->vao_cache));
+    const size_t num_bytes = (size_t)size * sizeof(_sg_gl_vao_cache_item_t);
+    ctx->vao_cache = (_sg_gl_vao_cache_item_t*) SOKOL_MALLOC(num_bytes);
+    SOKOL_ASSERT(ctx->vao_cache);
+    memset(ctx->vao_cache, 0, num_bytes);
+    ctx->vao_cache_size = size;
+    ctx->vao_cache_tick = 0;
+}
+
+_SOKOL_PRIVATE void _sg_gl_vao_cache_discard(_sg_context_t* ctx) {
+    SOKOL_ASSERT(ctx);
+    for (int i = 0; i < ctx->vao_cache_size; i++) {
+        if (ctx->vao_cache[i].vao) {
+            glDeleteVertexArrays(1, &ctx->vao_cache[i].vao);
+        }
+    }
+    SOKOL_FREE(ctx->vao_cache);
+    ctx->vao_cache = 0;
+    ctx->vao_cache_size = 0;
+}
+
+_SOKOL_PRIVATE void _sg_gl_bind_default_vao(void) {
+    _sg_context_t* ctx = _sg.gl.cur_context;
+    if (ctx && (_sg.gl.cache.cur_vao != ctx->vao)) {
+        glBindVertexArray(ctx->vao);
+        _sg.gl.cache.cur_vao = ctx->vao;
+        _sg.gl.cache.index_buffer = _sg.gl.cache.default_vao_index_buffer;
+        _sg.stats.gl.num_bind_vertex_array++;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_gl_bind_cached_vao(GLuint vao, GLuint ib) {
+    if (_sg.gl.cache.cur_vao != vao) {
+        if (_sg.gl.cache.cur_vao == _sg.gl.cur_context->vao) {
+            _sg.gl.cache.default_vao_index_buffer = _sg.gl.cache.index_buffer;
+        }
+        glBindVertexArray(vao);
+        _sg.gl.cache.cur_vao = vao;
+        _sg.gl.cache.index_buffer = ib;
+        _sg.stats.gl.num_bind_vertex_array++;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_gl_vao_cache_evict(_sg_gl_vao_cache_item_t* item) {
+    SOKOL_ASSERT(item->vao);
+    if (item->vao == _sg.gl.cache.cur_vao) {
+        _sg_gl_bind_default_vao();
+    }
+    glDeleteVertexArrays(1, &item->vao);
+    memset(item, 0, sizeof(_sg_gl_vao_cache_item_t));
+}
+
+/* called from _sg_gl_destroy_buffer(), a VAO keeps a deleted buffer alive and
+   a new buffer may come back with the same name */
+_SOKOL_PRIVATE void _sg_gl_vao_cache_invalidate_buffer(GLuint buf) {
+    _sg_context_t* ctx = _sg.gl.cur_context;
+    if (!ctx) {
+        return;
+    }
+    for (int i = 0; i < ctx->vao_cache_size; i++) {
+        _sg_gl_vao_cache_item_t* item = &ctx->vao_cache[i];
+        if (0 == item->vao) {
+            continue;
+        }
+        bool uses_buf = (item->key.ib == buf);
+        for (int vb_index = 0; vb_index < SG_MAX_SHADERSTAGE_BUFFERS; vb_index++) {
+            uses_buf |= (item->key.vbs[vb_index] == buf);
+        }
+        if (uses_buf) {
+            _sg_gl_vao_cache_evict(item);
+        }
+    }
+}
+
+/* called from _sg_gl_destroy_pipeline() */
+_SOKOL_PRIVATE void _sg_gl_vao_cache_invalidate_pipeline(uint32_t pip_id) {
+    _sg_context_t* ctx = _sg.gl.cur_context;
+    if (!ctx) {
+        return;
+    }
+    for (int i = 0; i < ctx->vao_cache_size; i++) {
+        _sg_gl_vao_cache_item_t* item = &ctx->vao_cache[i];
+        if (item->vao && (item->key.pip_id == pip_id)) {
+            _sg_gl_vao_cache_evict(item);
+        }
+    }
+}
+
+_SOKOL_PRIVATE uint32_t _sg_gl_vao_key_hash(const _sg_gl_vao_key_t* key) {
+    /* FNV-1a over the key words */
+    const uint32_t* words = (const uint32_t*) key;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < (sizeof(_sg_gl_vao_key_t) / sizeof(uint32_t)); i++) {
+        hash = (hash ^ words[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/* binds the VAO for these bindings, building it on a miss, false if the
+   bindings must go through the context's VAO */
+_SOKOL_PRIVATE bool _sg_gl_vao_cache_apply(_sg_pipeline_t* pip, _sg_buffer_t** vbs, const int* vb_offsets, int num_vbs, _sg_buffer_t* ib) {
+    _sg_context_t* ctx = _sg.gl.cur_context;
+    if (!ctx || (0 == ctx->vao_cache_size)) {
+        return false;
+    }
+    _sg_gl_vao_key_t key;
+    memset(&key, 0, sizeof(key));
+    key.pip_id = pip->slot.id;
+    if (ib) {
+        if (ib->cmn.usage == SG_USAGE_STREAM) {
+            return false;
+        }
+        key.ib = ib->gl.buf[ib->cmn.active_slot];
+    }
+    SOKOL_ASSERT(num_vbs <= SG_MAX_SHADERSTAGE_BUFFERS);
+    for (int i = 0; i < num_vbs; i++) {
+        if (vbs[i]->cmn.usage == SG_USAGE_STREAM) {
+            return false;
+        }
+        key.vbs[i] = vbs[i]->gl.buf[vbs[i]->cmn.active_slot];
+        key.vb_offsets[i] = vb_offsets[i];
+    }
+    const uint32_t hash = _sg_gl_vao_key_hash(&key);
+    const uint32_t tick = ++ctx->vao_cache_tick;
+
+    /* a hit, or the least recently used item */
+    _sg_gl_vao_cache_item_t* lru = &ctx->vao_cache[0];
+    for (int i = 0; i < ctx->vao_cache_size; i++) {
+        _sg_gl_vao_cache_item_t* item = &ctx->vao_cache[i];
+        if (item->vao && (item->hash == hash) && (0 == memcmp(&item->key, &key, sizeof(key)))) {
+            item->last_use = tick;
+            _sg_gl_bind_cached_vao(item->vao, key.ib);
+            return true;
+        }
+        if ((lru->vao != 0) && ((0 == item->vao) || ((tick - item->last_use) > (tick - lru->last_use)))) {
+            lru = item;
+        }
+    }
+    if (lru->vao) {
+        _sg_gl_vao_cache_evict(lru);
+    }
+
+    /* build the VAO, a fresh one has no index buffer and all attributes disabled */
+    _sg.stats.gl.num_vertex_array_cache_miss++;
+    lru->key = key;
+    lru->hash = hash;
+    lru->last_use = tick;
+    glGenVertexArrays(1, &lru->vao);
+    _sg_gl_bind_cached_vao(lru->vao, 0);
+    _sg_gl_cache_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, key.ib);
+    for (GLuint attr_index = 0; attr_index < (GLuint)_sg.limits.max_vertex_attrs; attr_index++) {
+        const _sg_gl_attr_t* attr = &pip->gl.attrs[attr_index];
+        if (attr->vb_index < 0) {
+            continue;
+        }
+        SOKOL_ASSERT(attr->vb_index < num_vbs);
+        _sg_gl_cache_bind_buffer(GL_ARRAY_BUFFER, key.vbs[attr->vb_index]);
+        glVertexAttribPointer(attr_index, attr->size, attr->type,
+            attr->normalized, attr->stride,
+            (const GLvoid*)(GLintptr)(key.vb_offsets[attr->vb_index] + attr->offset));
+        #if defined(_SOKOL_GL_INSTANCING_ENABLED)
+            if (_sg.features.instancing) {
+                glVertexAttribDivisor(attr_index, (GLuint)attr->divisor);
+            }
+        #endif
+        glEnableVertexAttribArray(attr_index);
+        _sg.stats.gl.num_vertex_attrib_pointer++;
+        _sg.stats.gl.num_enable_vertex_attrib_array++;
+    }
+    _SG_GL_CHECK_ERROR();
+    return true;
+}
+#endif
+
 _SOKOL_PRIVATE void _sg_gl_cache_active_texture(GLenum texture) {
     if (_sg.gl.cache.cur_active_texture != texture) {
         _sg.gl.cache.cur_active_texture = texture;
@@ -5927,6 +6421,10 @@ _SOKOL_PRIVATE void _sg_gl_cache_bind_texture(int slot_index, GLenum target, GLu
         }
         slot->target = target;
         slot->texture = texture;
+        _sg.stats.gl.num_bind_texture++;
+    }
+    else {
+        _sg.stats.gl.num_redundant_bind_texture++;
     }
 }
 
@@ -5972,6 +6470,268 @@ _SOKOL_PRIVATE void _sg_gl_cache_invalidate_program(GLuint prog) {
     }
 }
 
+/*-- stream ring implementation ----------------------------------------------*/
+#if defined(_SOKOL_GL_STREAM_RING)
+/* 1 second, waits only happen when the CPU is a whole ring ahead of the GPU */
+#define _SG_GL_RING_WAIT_NS (1000000000ull)
+
+/* align must be a power of two */
+_SOKOL_PRIVATE void _sg_gl_ring_init(_sg_gl_stream_ring_t* ring, int size, int align) {
+    memset(ring, 0, sizeof(_sg_gl_stream_ring_t));
+    #if defined(_SOKOL_USE_WIN32_GL_LOADER)
+    if (0 == glBufferStorage) {
+        return;
+    }
+    #endif
+    if (!_sg.gl.ext_buffer_storage || (size < align)) {
+        return;
+    }
+    ring->align = align;
+    ring->size = size & ~(align - 1);
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    _SG_GL_CHECK_ERROR();
+    glGenBuffers(1, &ring->buf);
+    _sg_gl_cache_store_buffer_binding(GL_ARRAY_BUFFER);
+    _sg_gl_cache_bind_buffer(GL_ARRAY_BUFFER, ring->buf);
+    glBufferStorage(GL_ARRAY_BUFFER, ring->size, 0, flags);
+    ring->ptr = (uint8_t*) glMapBufferRange(GL_ARRAY_BUFFER, 0, ring->size, flags);
+    _sg_gl_cache_restore_buffer_binding(GL_ARRAY_BUFFER);
+    if (0 == ring->ptr) {
+        SOKOL_LOG("sokol_gfx: failed to map a GL ring buffer, falling back to glBufferSubData\n");
+        _sg_gl_cache_invalidate_buffer(ring->buf);
+        glDeleteBuffers(1, &ring->buf);
+        ring->buf = 0;
+        while (glGetError() != GL_NO_ERROR);
+        return;
+    }
+    _SG_GL_CHECK_ERROR();
+    ring->valid = true;
+}
+
+/* drops the oldest frame once the GPU is done with it, false if there is none or it is still in use */
+_SOKOL_PRIVATE bool _sg_gl_ring_retire_frame(_sg_gl_stream_ring_t* ring, bool wait) {
+    if (0 == ring->num_frames) {
+        return false;
+    }
+    _sg_gl_ring_frame_t* frame = &ring->frames[ring->first_frame];
+    GLenum res = glClientWaitSync(frame->fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? _SG_GL_RING_WAIT_NS : 0);
+    while (wait && (res == GL_TIMEOUT_EXPIRED)) {
+        res = glClientWaitSync(frame->fence, GL_SYNC_FLUSH_COMMANDS_BIT, _SG_GL_RING_WAIT_NS);
+    }
+    if (res == GL_TIMEOUT_EXPIRED) {
+        return false;
+    }
+    /* on GL_WAIT_FAILED there is nothing left to wait for either */
+    glDeleteSync(frame->fence);
+    ring->tail = frame->end;
+    ring->used -= frame->used;
+    SOKOL_ASSERT(ring->used >= ring->frame_used);
+    ring->first_frame = (ring->first_frame + 1) % _SG_GL_RING_MAX_FRAMES;
+    ring->num_frames--;
+    return true;
+}
+
+_SOKOL_PRIVATE void _sg_gl_ring_discard(_sg_gl_stream_ring_t* ring) {
+    if (!ring->valid) {
+        return;
+    }
+    while (_sg_gl_ring_retire_frame(ring, true));
+    _sg_gl_cache_store_buffer_binding(GL_ARRAY_BUFFER);
+    _sg_gl_cache_bind_buffer(GL_ARRAY_BUFFER, ring->buf);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    _sg_gl_cache_restore_buffer_binding(GL_ARRAY_BUFFER);
+    _sg_gl_cache_invalidate_buffer(ring->buf);
+    glDeleteBuffers(1, &ring->buf);
+    _SG_GL_CHECK_ERROR();
+    memset(ring, 0, sizeof(_sg_gl_stream_ring_t));
+}
+
+/* returns the ring offset of num_bytes for the current frame, or -1 if they don't fit */
+_SOKOL_PRIVATE int _sg_gl_ring_alloc(_sg_gl_stream_ring_t* ring, int num_bytes) {
+    SOKOL_ASSERT(ring->valid && (num_bytes > 0));
+    num_bytes = _sg_roundup(num_bytes, ring->align);
+    if (num_bytes > ring->size) {
+        return -1;
+    }
+    for (;;) {
+        if (0 == ring->used) {
+            ring->head = ring->tail = 0;
+        }
+        int offset = -1;
+        int padding = 0;
+        if ((ring->head > ring->tail) || (0 == ring->used)) {
+            /* free space is [head, size) and [0, tail) */
+            if ((ring->head + num_bytes) <= ring->size) {
+                offset = ring->head;
+            }
+            else if (num_bytes <= ring->tail) {
+                padding = ring->size - ring->head;
+                offset = 0;
+            }
+        }
+        else if ((ring->head + num_bytes) <= ring->tail) {
+            /* free space is [head, tail) */
+            offset = ring->head;
+        }
+        if (offset >= 0) {
+            ring->head = offset + num_bytes;
+            ring->used += padding + num_bytes;
+            ring->frame_used += padding + num_bytes;
+            return offset;
+        }
+        /* the whole ring belongs to the current frame, don't wait on ourselves */
+        if (!_sg_gl_ring_retire_frame(ring, true)) {
+            return -1;
+        }
+    }
+}
+
+/* called from sg_commit(), fences the allocations made in this frame */
+_SOKOL_PRIVATE void _sg_gl_ring_end_frame(_sg_gl_stream_ring_t* ring) {
+    if (!ring->valid) {
+        return;
+    }
+    if (ring->frame_used > 0) {
+        if (ring->num_frames == _SG_GL_RING_MAX_FRAMES) {
+            _sg_gl_ring_retire_frame(ring, true);
+        }
+        const int index = (ring->first_frame + ring->num_frames) % _SG_GL_RING_MAX_FRAMES;
+        ring->frames[index].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        ring->frames[index].end = ring->head;
+        ring->frames[index].used = ring->frame_used;
+        ring->num_frames++;
+        ring->frame_used = 0;
+    }
+    /* give back what the GPU is already done with, without waiting */
+    while (_sg_gl_ring_retire_frame(ring, false));
+}
+
+/* places this frame's content of a STREAM buffer in the ring, false if it takes the glBufferSubData path */
+_SOKOL_PRIVATE bool _sg_gl_ring_reserve(_sg_buffer_t* buf, int num_bytes) {
+    if (!_sg.gl.ring.valid || buf->gl.ext_buffers || (buf->cmn.usage != SG_USAGE_STREAM)) {
+        return false;
+    }
+    const int offset = _sg_gl_ring_alloc(&_sg.gl.ring, num_bytes);
+    if (offset < 0) {
+        return false;
+    }
+    buf->gl.ring_offset = offset;
+    return true;
+}
+#endif
+
+#if defined(_SOKOL_GL_STREAM_RING)
+/* ring space is reused once the frame which wrote it retires, so the content only lives for that frame */
+_SOKOL_PRIVATE bool _sg_gl_ring_content_current(const _sg_buffer_t* buf) {
+    return !buf->gl.in_ring ||
+           (buf->cmn.update_frame_index == _sg.frame_index) ||
+           (buf->cmn.append_frame_index == _sg.frame_index);
+}
+#endif
+
+/* the GL buffer holding the current content of buf, and the offset of the content in it */
+_SOKOL_PRIVATE GLuint _sg_gl_buffer_binding(const _sg_buffer_t* buf, int* offset) {
+    #if defined(_SOKOL_GL_STREAM_RING)
+    if (buf->gl.in_ring) {
+        *offset = buf->gl.ring_offset;
+        return _sg.gl.ring.buf;
+    }
+    #endif
+    *offset = 0;
+    return buf->gl.buf[buf->cmn.active_slot];
+}
+
+#if defined(SOKOL_GLCORE33)
+_SOKOL_PRIVATE void _sg_gl_uniform_ring_init(int size) {
+    _sg_gl_uniform_ring_t* ub = &_sg.gl.ub_ring;
+    memset(ub, 0, sizeof(_sg_gl_uniform_ring_t));
+    GLint align = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align);
+    if ((align <= 0) || (align & (align - 1))) {
+        /* not a power of two, 256 is the largest alignment seen in the wild */
+        align = 256;
+    }
+    ub->align = align;
+    ub->size = size & ~(align - 1);
+    #if defined(_SOKOL_GL_STREAM_RING)
+    _sg_gl_ring_init(&ub->ring, size, align);
+    #endif
+    /* the glBufferSubData() buffer is only created once it is needed */
+    ub->valid = ub->size > 0;
+}
+
+_SOKOL_PRIVATE void _sg_gl_uniform_ring_discard(void) {
+    _sg_gl_uniform_ring_t* ub = &_sg.gl.ub_ring;
+    #if defined(_SOKOL_GL_STREAM_RING)
+    _sg_gl_ring_discard(&ub->ring);
+    #endif
+    if (ub->buf) {
+        glDeleteBuffers(1, &ub->buf);
+        _SG_GL_CHECK_ERROR();
+    }
+    memset(ub, 0, sizeof(_sg_gl_uniform_ring_t));
+}
+
+_SOKOL_PRIVATE void _sg_gl_uniform_ring_end_frame(void) {
+    #if defined(_SOKOL_GL_STREAM_RING)
+    _sg_gl_ring_end_frame(&_sg.gl.ub_ring.ring);
+    #endif
+}
+
+/* the uniform buffer binding point of a uniform block */
+_SOKOL_PRIVATE GLuint _sg_gl_uniform_binding(int stage_index, int ub_index) {
+    return (GLuint)(stage_index * SG_MAX_SHADERSTAGE_UBS + ub_index);
+}
+
+/* copies the uniform data into the next range of the uniform ring and binds that range */
+_SOKOL_PRIVATE void _sg_gl_apply_uniform_block(GLuint binding, const _sg_gl_uniform_block_t* gl_ub, const sg_range* data) {
+    _sg_gl_uniform_ring_t* ub = &_sg.gl.ub_ring;
+    SOKOL_ASSERT(ub->valid && (gl_ub->gl_size > 0));
+    /* the std140 block may be padded past the end of the uniform data */
+    const GLsizeiptr num_bytes = gl_ub->gl_size;
+    const size_t copy_size = _sg_min(data->size, (size_t)gl_ub->gl_size);
+    GLuint gl_buf = 0;
+    int offset = 0;
+    #if defined(_SOKOL_GL_STREAM_RING)
+    if (ub->ring.valid) {
+        /* a frame which doesn't fit into the ring spills into the glBufferSubData() path */
+        offset = _sg_gl_ring_alloc(&ub->ring, gl_ub->gl_size);
+        if (offset >= 0) {
+            memcpy(ub->ring.ptr + offset, data->ptr, copy_size);
+            gl_buf = ub->ring.buf;
+        }
+    }
+    #endif
+    if (0 == gl_buf) {
+        const int aligned_size = _sg_roundup(gl_ub->gl_size, ub->align);
+        if (aligned_size > ub->size) {
+            SOKOL_LOG("sokol_gfx: uniform block larger than sg_desc.uniform_buffer_size\n");
+            return;
+        }
+        if (0 == ub->buf) {
+            glGenBuffers(1, &ub->buf);
+            glBindBuffer(GL_UNIFORM_BUFFER, ub->buf);
+            glBufferData(GL_UNIFORM_BUFFER, ub->size, 0, GL_STREAM_DRAW);
+            ub->offset = 0;
+        }
+        else {
+            glBindBuffer(GL_UNIFORM_BUFFER, ub->buf);
+        }
+        if ((ub->offset + aligned_size) > ub->size) {
+            /* draws already issued keep reading the orphaned storage */
+            glBufferData(GL_UNIFORM_BUFFER, ub->size, 0, GL_STREAM_DRAW);
+            ub->offset = 0;
+        }
+        offset = ub->offset;
+        ub->offset += aligned_size;
+        glBufferSubData(GL_UNIFORM_BUFFER, offset, (GLsizeiptr)copy_size, data->ptr);
+        gl_buf = ub->buf;
+    }
+    glBindBufferRange(GL_UNIFORM_BUFFER, binding, gl_buf, offset, num_bytes);
+    _sg.stats.gl.num_bind_uniform_buffer++;
+}
+#endif
+
 _SOKOL_PRIVATE void _sg_gl_reset_state_cache(void) {
     if (_sg.gl.cur_context) {
         _SG_GL_CHECK_ERROR();
@@ -5982,6 +6742,9 @@ _SOKOL_PRIVATE void _sg_gl_reset_state_cache(void) {
         }
         #endif
         memset(&_sg.gl.cache, 0, sizeof(_sg.gl.cache));
+        #if !defined(SOKOL_GLES2)
+        _sg.gl.cache.cur_vao = _sg.gl.cur_context->vao;
+        #endif
         _sg_gl_cache_clear_buffer_bindings(true);
         _SG_GL_CHECK_ERROR();
         _sg_gl_cache_clear_texture_bindings(true);
@@ -6083,10 +6846,22 @@ _SOKOL_PRIVATE void _sg_gl_setup_backend(const sg_desc* desc) {
     #else
         _sg_gl_init_caps_gles2();
     #endif
+    #if defined(_SOKOL_GL_STREAM_RING)
+        _sg_gl_ring_init(&_sg.gl.ring, desc->staging_buffer_size, _SG_GL_RING_ALIGN);
+    #endif
+    #if defined(SOKOL_GLCORE33)
+        _sg_gl_uniform_ring_init(desc->uniform_buffer_size);
+    #endif
 }
 
 _SOKOL_PRIVATE void _sg_gl_discard_backend(void) {
     SOKOL_ASSERT(_sg.gl.valid);
+    #if defined(_SOKOL_GL_STREAM_RING)
+        _sg_gl_ring_discard(&_sg.gl.ring);
+    #endif
+    #if defined(SOKOL_GLCORE33)
+        _sg_gl_uniform_ring_discard();
+    #endif
     _sg.gl.valid = false;
     #if defined(_SOKOL_USE_WIN32_GL_LOADER)
     _sg_gl_unload_opengl();
@@ -6113,6 +6888,7 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_context(_sg_context_t* ctx) {
         glGenVertexArrays(1, &ctx->vao);
         glBindVertexArray(ctx->vao);
         _SG_GL_CHECK_ERROR();
+        _sg_gl_vao_cache_init(ctx, _sg.desc.context.gl.vao_cache_size);
     }
     #endif
     return SG_RESOURCESTATE_VALID;
@@ -6122,6 +6898,12 @@ _SOKOL_PRIVATE void _sg_gl_destroy_context(_sg_context_t* ctx) {
     SOKOL_ASSERT(ctx);
     #if !defined(SOKOL_GLES2)
     if (!_sg.gl.gles2) {
+        if (ctx->vao_cache) {
+            if (_sg.gl.cur_context == ctx) {
+                _sg_gl_bind_default_vao();
+            }
+            _sg_gl_vao_cache_discard(ctx);
+        }
         if (ctx->vao) {
             glDeleteVertexArrays(1, &ctx->vao);
         }
@@ -6167,6 +6949,9 @@ _SOKOL_PRIVATE void _sg_gl_destroy_buffer(_sg_buffer_t* buf) {
     _SG_GL_CHECK_ERROR();
     for (int slot = 0; slot < buf->cmn.num_slots; slot++) {
         if (buf->gl.buf[slot]) {
+            #if !defined(SOKOL_GLES2)
+            _sg_gl_vao_cache_invalidate_buffer(buf->gl.buf[slot]);
+            #endif
             _sg_gl_cache_invalidate_buffer(buf->gl.buf[slot]);
             if (!buf->gl.ext_buffers) {
                 glDeleteBuffers(1, &buf->gl.buf[slot]);
@@ -6306,6 +7091,8 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_
                     const float max_lod = _sg_clamp(desc->max_lod, 0.0f, 1000.0f);
                     glTexParameterf(img->gl.target, GL_TEXTURE_MIN_LOD, min_lod);
                     glTexParameterf(img->gl.target, GL_TEXTURE_MAX_LOD, max_lod);
+                    /* a partial mip chain is only texture-complete with the max level set */
+                    glTexParameteri(img->gl.target, GL_TEXTURE_MAX_LEVEL, img->cmn.num_mipmaps - 1);
                 }
                 #endif
                 const int num_faces = img->cmn.type == SG_IMAGETYPE_CUBE ? 6 : 1;
@@ -6483,6 +7270,30 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
                 ub->num_uniforms++;
             }
             SOKOL_ASSERT(ub_desc->size == (size_t)cur_uniform_offset);
+            #if defined(SOKOL_GLCORE33)
+            /* GLSL code which declares the uniforms inside a std140 uniform
+               block gets them from the uniform ring instead of glUniform*()
+            */
+            if ((ub->num_uniforms > 0) && ub_desc->uniforms[0].name && _sg.gl.ub_ring.valid) {
+                const GLchar* u_name = ub_desc->uniforms[0].name;
+                GLuint u_index = GL_INVALID_INDEX;
+                GLint block_index = -1;
+                glGetUniformIndices(gl_prog, 1, &u_name, &u_index);
+                if (u_index != GL_INVALID_INDEX) {
+                    glGetActiveUniformsiv(gl_prog, 1, &u_index, GL_UNIFORM_BLOCK_INDEX, &block_index);
+                }
+                if (block_index >= 0) {
+                    GLint block_size = 0;
+                    glGetActiveUniformBlockiv(gl_prog, (GLuint)block_index, GL_UNIFORM_BLOCK_DATA_SIZE, &block_size);
+                    if ((size_t)block_size < ub_desc->size) {
+                        SOKOL_LOG("sokol_gfx: GLSL uniform block is smaller than the uniform block desc\n");
+                        return SG_RESOURCESTATE_FAILED;
+                    }
+                    glUniformBlockBinding(gl_prog, (GLuint)block_index, _sg_gl_uniform_binding(stage_index, ub_index));
+                    ub->gl_size = block_size;
+                }
+            }
+            #endif
         }
     }
 
@@ -6594,8 +7405,11 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_pipeline(_sg_pipeline_t* pip, _sg
 
 _SOKOL_PRIVATE void _sg_gl_destroy_pipeline(_sg_pipeline_t* pip) {
     SOKOL_ASSERT(pip);
+    #if !defined(SOKOL_GLES2)
+    _sg_gl_vao_cache_invalidate_pipeline(pip->slot.id);
+    #else
     _SOKOL_UNUSED(pip);
-    /* empty */
+    #endif
 }
 
 /*
@@ -7192,8 +8006,12 @@ _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
         if (pip->shader->gl.prog != _sg.gl.cache.prog) {
             _sg.gl.cache.prog = pip->shader->gl.prog;
             glUseProgram(pip->shader->gl.prog);
+            _sg.stats.gl.num_use_program++;
         }
     }
+    else {
+        _sg.stats.gl.num_redundant_pipeline++;
+    }
     _SG_GL_CHECK_ERROR();
 }
 
@@ -7208,6 +8026,13 @@ _SOKOL_PRIVATE void _sg_gl_apply_bindings(
     _SOKOL_UNUSED(num_fs_imgs);
     _SOKOL_UNUSED(num_vs_imgs);
     _SOKOL_UNUSED(num_vbs);
+    #if defined(_SOKOL_GL_STREAM_RING)
+    /* a STREAM buffer must be updated or appended to in every frame it is bound in */
+    for (int i = 0; i < num_vbs; i++) {
+        SOKOL_ASSERT(_sg_gl_ring_content_current(vbs[i]));
+    }
+    SOKOL_ASSERT(!ib || _sg_gl_ring_content_current(ib));
+    #endif
     _SG_GL_CHECK_ERROR();
 
     /* bind textures */
@@ -7230,10 +8055,20 @@ _SOKOL_PRIVATE void _sg_gl_apply_bindings(
     }
     _SG_GL_CHECK_ERROR();
 
+    #if !defined(SOKOL_GLES2)
+    /* a pipeline and buffers seen before only need their VAO bound */
+    if (_sg_gl_vao_cache_apply(pip, vbs, vb_offsets, num_vbs, ib)) {
+        _sg.gl.cache.cur_ib_offset = ib_offset;
+        return;
+    }
+    _sg_gl_bind_default_vao();
+    #endif
+
     /* index buffer (can be 0) */
-    const GLuint gl_ib = ib ? ib->gl.buf[ib->cmn.active_slot] : 0;
+    int ib_base = 0;
+    const GLuint gl_ib = ib ? _sg_gl_buffer_binding(ib, &ib_base) : 0;
     _sg_gl_cache_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, gl_ib);
-    _sg.gl.cache.cur_ib_offset = ib_offset;
+    _sg.gl.cache.cur_ib_offset = ib_base + ib_offset;
 
     /* vertex attributes */
     for (GLuint attr_index = 0; attr_index < (GLuint)_sg.limits.max_vertex_attrs; attr_index++) {
@@ -7247,8 +8082,9 @@ _SOKOL_PRIVATE void _sg_gl_apply_bindings(
             SOKOL_ASSERT(attr->vb_index < num_vbs);
             _sg_buffer_t* vb = vbs[attr->vb_index];
             SOKOL_ASSERT(vb);
-            gl_vb = vb->gl.buf[vb->cmn.active_slot];
-            vb_offset = vb_offsets[attr->vb_index] + attr->offset;
+            int vb_base = 0;
+            gl_vb = _sg_gl_buffer_binding(vb, &vb_base);
+            vb_offset = vb_base + vb_offsets[attr->vb_index] + attr->offset;
             if ((gl_vb != cache_attr->gl_vbuf) ||
                 (attr->size != cache_attr->gl_attr.size) ||
                 (attr->type != cache_attr->gl_attr.type) ||
@@ -7266,10 +8102,15 @@ _SOKOL_PRIVATE void _sg_gl_apply_bindings(
                         glVertexAttribDivisor(attr_index, (GLuint)attr->divisor);
                     }
                 #endif
+                _sg.stats.gl.num_vertex_attrib_pointer++;
                 cache_attr_dirty = true;
             }
+            else {
+                _sg.stats.gl.num_redundant_vertex_attrib++;
+            }
             if (cache_attr->gl_attr.vb_index == -1) {
                 glEnableVertexAttribArray(attr_index);
+                _sg.stats.gl.num_enable_vertex_attrib_array++;
                 cache_attr_dirty = true;
             }
         }
@@ -7277,6 +8118,7 @@ _SOKOL_PRIVATE void _sg_gl_apply_bindings(
             /* attribute is disabled */
             if (cache_attr->gl_attr.vb_index != -1) {
                 glDisableVertexAttribArray(attr_index);
+                _sg.stats.gl.num_disable_vertex_attrib_array++;
                 cache_attr_dirty = true;
             }
         }
@@ -7297,6 +8139,12 @@ _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_in
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline->shader->cmn.stage[stage_index].uniform_blocks[ub_index].size == data->size);
     const _sg_gl_shader_stage_t* gl_stage = &_sg.gl.cache.cur_pipeline->shader->gl.stage[stage_index];
     const _sg_gl_uniform_block_t* gl_ub = &gl_stage->uniform_blocks[ub_index];
+    #if defined(SOKOL_GLCORE33)
+    if (gl_ub->gl_size > 0) {
+        _sg_gl_apply_uniform_block(_sg_gl_uniform_binding(stage_index, ub_index), gl_ub, data);
+        return;
+    }
+    #endif
     for (int u_index = 0; u_index < gl_ub->num_uniforms; u_index++) {
         const _sg_gl_uniform_t* u = &gl_ub->uniforms[u_index];
         SOKOL_ASSERT(u->type != SG_UNIFORMTYPE_INVALID);
@@ -7304,6 +8152,7 @@ _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_in
             continue;
         }
         GLfloat* ptr = (GLfloat*) (((uint8_t*)data->ptr) + u->offset);
+        _sg.stats.gl.num_uniform++;
         switch (u->type) {
             case SG_UNIFORMTYPE_INVALID:
                 break;
@@ -7361,13 +8210,30 @@ _SOKOL_PRIVATE void _sg_gl_draw(int base_element, int num_elements, int num_inst
 
 _SOKOL_PRIVATE void _sg_gl_commit(void) {
     SOKOL_ASSERT(!_sg.gl.in_pass);
+    #if !defined(SOKOL_GLES2)
+    /* unbinding the index buffer must not touch a cached VAO */
+    _sg_gl_bind_default_vao();
+    #endif
     /* "soft" clear bindings (only those that are actually bound) */
     _sg_gl_cache_clear_buffer_bindings(false);
     _sg_gl_cache_clear_texture_bindings(false);
+    #if defined(_SOKOL_GL_STREAM_RING)
+    _sg_gl_ring_end_frame(&_sg.gl.ring);
+    #endif
+    #if defined(SOKOL_GLCORE33)
+    _sg_gl_uniform_ring_end_frame();
+    #endif
 }
 
 _SOKOL_PRIVATE void _sg_gl_update_buffer(_sg_buffer_t* buf, const sg_range* data) {
     SOKOL_ASSERT(buf && data && data->ptr && (data->size > 0));
+    #if defined(_SOKOL_GL_STREAM_RING)
+    buf->gl.in_ring = _sg_gl_ring_reserve(buf, (int)data->size);
+    if (buf->gl.in_ring) {
+        memcpy(_sg.gl.ring.ptr + buf->gl.ring_offset, data->ptr, data->size);
+        return;
+    }
+    #endif
     /* only one update per buffer per frame allowed */
     if (++buf->cmn.active_slot >= buf->cmn.num_slots) {
         buf->cmn.active_slot = 0;
@@ -7386,6 +8252,16 @@ _SOKOL_PRIVATE void _sg_gl_update_buffer(_sg_buffer_t* buf, const sg_range* data
 
 _SOKOL_PRIVATE int _sg_gl_append_buffer(_sg_buffer_t* buf, const sg_range* data, bool new_frame) {
     SOKOL_ASSERT(buf && data && data->ptr && (data->size > 0));
+    #if defined(_SOKOL_GL_STREAM_RING)
+    if (new_frame) {
+        /* reserve the whole buffer, the appends of a frame must stay contiguous */
+        buf->gl.in_ring = _sg_gl_ring_reserve(buf, buf->cmn.size);
+    }
+    if (buf->gl.in_ring) {
+        memcpy(_sg.gl.ring.ptr + buf->gl.ring_offset + buf->cmn.append_pos, data->ptr, data->size);
+        return _sg_roundup((int)data->size, 4);
+    }
+    #endif
     if (new_frame) {
         if (++buf->cmn.active_slot >= buf->cmn.num_slots) {
             buf->cmn.active_slot = 0;
@@ -9674,8 +10550,48 @@ _SOKOL_PRIVATE void _sg_mtl_destroy_pool(void) {
     _SG_OBJC_RELEASE(_sg.mtl.idpool.pool);
 }
 
+/*  double the number of slots, called when the resource pools have grown
+    past what the initial sg_desc pool sizes accounted for, the pending
+    release items are compacted to the start of the new release queue
+*/
+_SOKOL_PRIVATE void _sg_mtl_grow_pool(void) {
+    const int old_num_slots = _sg.mtl.idpool.num_slots;
+    const int new_num_slots = 2 * old_num_slots;
+    NSNull* null = [NSNull null];
+    for (int i = old_num_slots; i < new_num_slots; i++) {
+        [_sg.mtl.idpool.pool addObject:null];
+    }
+    SOKOL_ASSERT([_sg.mtl.idpool.pool count] == (NSUInteger)new_num_slots);
+
+    int* free_queue = (int*)SOKOL_MALLOC((size_t)new_num_slots * sizeof(int));
+    memcpy(free_queue, _sg.mtl.idpool.free_queue, (size_t)_sg.mtl.idpool.free_queue_top * sizeof(int));
+    SOKOL_FREE(_sg.mtl.idpool.free_queue);
+    _sg.mtl.idpool.free_queue = free_queue;
+    for (int i = new_num_slots-1; i >= old_num_slots; i--) {
+        _sg.mtl.idpool.free_queue[_sg.mtl.idpool.free_queue_top++] = i;
+    }
+
+    _sg_mtl_release_item_t* release_queue = (_sg_mtl_release_item_t*)SOKOL_MALLOC((size_t)new_num_slots * sizeof(_sg_mtl_release_item_t));
+    int num_pending = 0;
+    for (int i = _sg.mtl.idpool.release_queue_back; i != _sg.mtl.idpool.release_queue_front; i = (i + 1) % old_num_slots) {
+        release_queue[num_pending++] = _sg.mtl.idpool.release_queue[i];
+    }
+    for (int i = num_pending; i < new_num_slots; i++) {
+        release_queue[i].frame_index = 0;
+        release_queue[i].slot_index = _SG_MTL_INVALID_SLOT_INDEX;
+    }
+    SOKOL_FREE(_sg.mtl.idpool.release_queue);
+    _sg.mtl.idpool.release_queue = release_queue;
+    _sg.mtl.idpool.release_queue_back = 0;
+    _sg.mtl.idpool.release_queue_front = num_pending;
+    _sg.mtl.idpool.num_slots = new_num_slots;
+}
+
 /* get a new free resource pool slot */
 _SOKOL_PRIVATE int _sg_mtl_alloc_pool_slot(void) {
+    if (0 == _sg.mtl.idpool.free_queue_top) {
+        _sg_mtl_grow_pool();
+    }
     SOKOL_ASSERT(_sg.mtl.idpool.free_queue_top > 0);
     const int slot_index = _sg.mtl.idpool.free_queue[--_sg.mtl.idpool.free_queue_top];
     SOKOL_ASSERT((slot_index > 0) && (slot_index < _sg.mtl.idpool.num_slots));
@@ -13180,25 +14096,57 @@ static inline void _sg_update_image(_sg_image_t* img, const sg_image_data* data)
 
 /*== RESOURCE POOLS ==========================================================*/
 
-_SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num) {
-    SOKOL_ASSERT(pool && (num >= 1));
-    /* slot 0 is reserved for the 'invalid id', so bump the pool size by 1 */
-    pool->size = num + 1;
-    pool->queue_top = 0;
-    /* generation counters indexable by pool slot index, slot 0 is reserved */
-    size_t gen_ctrs_size = sizeof(uint32_t) * (size_t)pool->size;
-    pool->gen_ctrs = (uint32_t*) SOKOL_MALLOC(gen_ctrs_size);
-    SOKOL_ASSERT(pool->gen_ctrs);
-    memset(pool->gen_ctrs, 0, gen_ctrs_size);
-    /* it's not a bug to only reserve 'num' here */
-    pool->free_queue = (int*) SOKOL_MALLOC(sizeof(int) * (size_t)num);
-    SOKOL_ASSERT(pool->free_queue);
+/* appends a chunk of num zeroed items and puts their slots into the free queue */
+_SOKOL_PRIVATE void _sg_pool_add_chunk(_sg_pool_t* pool, int num) {
+    SOKOL_ASSERT(pool && (num >= 1) && (pool->item_size > 0));
+    SOKOL_ASSERT(pool->num_chunks < _SG_MAX_POOL_CHUNKS);
+    SOKOL_ASSERT((pool->size + num) <= _SG_MAX_POOL_SIZE);
+    const int old_size = pool->size;
+    const int new_size = old_size + num;
+
+    size_t chunk_size = pool->item_size * (size_t)num;
+    uint8_t* chunk = (uint8_t*) SOKOL_MALLOC(chunk_size);
+    SOKOL_ASSERT(chunk);
+    memset(chunk, 0, chunk_size);
+    pool->chunk_start[pool->num_chunks] = old_size;
+    pool->chunks[pool->num_chunks++] = chunk;
+
+    /* generation counters and the free queue are only ever accessed by
+       index, so unlike the items they may move to a bigger allocation
+    */
+    size_t gen_ctrs_size = sizeof(uint32_t) * (size_t)new_size;
+    uint32_t* gen_ctrs = (uint32_t*) SOKOL_MALLOC(gen_ctrs_size);
+    SOKOL_ASSERT(gen_ctrs);
+    memset(gen_ctrs, 0, gen_ctrs_size);
+    /* it's not a bug to only reserve 'size-1' here, slot 0 is never queued */
+    int* free_queue = (int*) SOKOL_MALLOC(sizeof(int) * (size_t)(new_size - 1));
+    SOKOL_ASSERT(free_queue);
+    if (pool->gen_ctrs) {
+        memcpy(gen_ctrs, pool->gen_ctrs, sizeof(uint32_t) * (size_t)old_size);
+        SOKOL_FREE(pool->gen_ctrs);
+    }
+    if (pool->free_queue) {
+        memcpy(free_queue, pool->free_queue, sizeof(int) * (size_t)pool->queue_top);
+        SOKOL_FREE(pool->free_queue);
+    }
+    pool->gen_ctrs = gen_ctrs;
+    pool->free_queue = free_queue;
+    pool->size = new_size;
+
     /* never allocate the zero-th pool item since the invalid id is 0 */
-    for (int i = pool->size-1; i >= 1; i--) {
+    for (int i = new_size-1; (i >= old_size) && (i >= 1); i--) {
         pool->free_queue[pool->queue_top++] = i;
     }
 }
 
+_SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num, size_t item_size) {
+    SOKOL_ASSERT(pool && (num >= 1) && (item_size > 0));
+    memset(pool, 0, sizeof(_sg_pool_t));
+    pool->item_size = item_size;
+    /* slot 0 is reserved for the 'invalid id', so bump the pool size by 1 */
+    _sg_pool_add_chunk(pool, num + 1);
+}
+
 _SOKOL_PRIVATE void _sg_discard_pool(_sg_pool_t* pool) {
     SOKOL_ASSERT(pool);
     SOKOL_ASSERT(pool->free_queue);
@@ -13207,22 +14155,52 @@ _SOKOL_PRIVATE void _sg_discard_pool(_sg_pool_t* pool) {
     SOKOL_ASSERT(pool->gen_ctrs);
     SOKOL_FREE(pool->gen_ctrs);
     pool->gen_ctrs = 0;
+    for (int i = 0; i < pool->num_chunks; i++) {
+        SOKOL_FREE(pool->chunks[i]);
+        pool->chunks[i] = 0;
+    }
+    pool->num_chunks = 0;
     pool->size = 0;
     pool->queue_top = 0;
 }
 
+/* doubles the pool, returns false when it is already at _SG_MAX_POOL_SIZE */
+_SOKOL_PRIVATE bool _sg_pool_grow(_sg_pool_t* pool) {
+    SOKOL_ASSERT(pool);
+    int num = pool->size;
+    if (num > (_SG_MAX_POOL_SIZE - pool->size)) {
+        num = _SG_MAX_POOL_SIZE - pool->size;
+    }
+    if (num <= 0) {
+        return false;
+    }
+    _sg_pool_add_chunk(pool, num);
+    pool->grow_count++;
+    return true;
+}
+
+/* pointer to the item at slot_index, stays valid until the pool is discarded */
+_SOKOL_PRIVATE void* _sg_pool_item(const _sg_pool_t* pool, int slot_index) {
+    SOKOL_ASSERT(pool && (pool->num_chunks > 0));
+    SOKOL_ASSERT((slot_index >= 0) && (slot_index < pool->size));
+    /* chunks double in size, so only the most recent ones are worth checking first */
+    int chunk = pool->num_chunks - 1;
+    while (slot_index < pool->chunk_start[chunk]) {
+        chunk--;
+    }
+    return pool->chunks[chunk] + pool->item_size * (size_t)(slot_index - pool->chunk_start[chunk]);
+}
+
 _SOKOL_PRIVATE int _sg_pool_alloc_index(_sg_pool_t* pool) {
     SOKOL_ASSERT(pool);
     SOKOL_ASSERT(pool->free_queue);
-    if (pool->queue_top > 0) {
-        int slot_index = pool->free_queue[--pool->queue_top];
-        SOKOL_ASSERT((slot_index > 0) && (slot_index < pool->size));
-        return slot_index;
-    }
-    else {
+    if ((pool->queue_top == 0) && !_sg_pool_grow(pool)) {
         /* pool exhausted */
         return _SG_INVALID_SLOT_INDEX;
     }
+    int slot_index = pool->free_queue[--pool->queue_top];
+    SOKOL_ASSERT((slot_index > 0) && (slot_index < pool->size));
+    return slot_index;
 }
 
 _SOKOL_PRIVATE void _sg_pool_free_index(_sg_pool_t* pool, int slot_index) {
@@ -13296,58 +14274,25 @@ _SOKOL_PRIVATE void _sg_reset_context(_sg_context_t* ctx) {
 _SOKOL_PRIVATE void _sg_setup_pools(_sg_pools_t* p, const sg_desc* desc) {
     SOKOL_ASSERT(p);
     SOKOL_ASSERT(desc);
-    /* note: the pools here will have an additional item, since slot 0 is reserved */
+    /* note: the pools here will have an additional item, since slot 0 is reserved,
+       the sizes in sg_desc are only the initial sizes, pools grow on demand
+    */
     SOKOL_ASSERT((desc->buffer_pool_size > 0) && (desc->buffer_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->buffer_pool, desc->buffer_pool_size);
-    size_t buffer_pool_byte_size = sizeof(_sg_buffer_t) * (size_t)p->buffer_pool.size;
-    p->buffers = (_sg_buffer_t*) SOKOL_MALLOC(buffer_pool_byte_size);
-    SOKOL_ASSERT(p->buffers);
-    memset(p->buffers, 0, buffer_pool_byte_size);
-
+    _sg_init_pool(&p->buffer_pool, desc->buffer_pool_size, sizeof(_sg_buffer_t));
     SOKOL_ASSERT((desc->image_pool_size > 0) && (desc->image_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->image_pool, desc->image_pool_size);
-    size_t image_pool_byte_size = sizeof(_sg_image_t) * (size_t)p->image_pool.size;
-    p->images = (_sg_image_t*) SOKOL_MALLOC(image_pool_byte_size);
-    SOKOL_ASSERT(p->images);
-    memset(p->images, 0, image_pool_byte_size);
-
+    _sg_init_pool(&p->image_pool, desc->image_pool_size, sizeof(_sg_image_t));
     SOKOL_ASSERT((desc->shader_pool_size > 0) && (desc->shader_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->shader_pool, desc->shader_pool_size);
-    size_t shader_pool_byte_size = sizeof(_sg_shader_t) * (size_t)p->shader_pool.size;
-    p->shaders = (_sg_shader_t*) SOKOL_MALLOC(shader_pool_byte_size);
-    SOKOL_ASSERT(p->shaders);
-    memset(p->shaders, 0, shader_pool_byte_size);
-
+    _sg_init_pool(&p->shader_pool, desc->shader_pool_size, sizeof(_sg_shader_t));
     SOKOL_ASSERT((desc->pipeline_pool_size > 0) && (desc->pipeline_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->pipeline_pool, desc->pipeline_pool_size);
-    size_t pipeline_pool_byte_size = sizeof(_sg_pipeline_t) * (size_t)p->pipeline_pool.size;
-    p->pipelines = (_sg_pipeline_t*) SOKOL_MALLOC(pipeline_pool_byte_size);
-    SOKOL_ASSERT(p->pipelines);
-    memset(p->pipelines, 0, pipeline_pool_byte_size);
-
+    _sg_init_pool(&p->pipeline_pool, desc->pipeline_pool_size, sizeof(_sg_pipeline_t));
     SOKOL_ASSERT((desc->pass_pool_size > 0) && (desc->pass_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->pass_pool, desc->pass_pool_size);
-    size_t pass_pool_byte_size = sizeof(_sg_pass_t) * (size_t)p->pass_pool.size;
-    p->passes = (_sg_pass_t*) SOKOL_MALLOC(pass_pool_byte_size);
-    SOKOL_ASSERT(p->passes);
-    memset(p->passes, 0, pass_pool_byte_size);
-
+    _sg_init_pool(&p->pass_pool, desc->pass_pool_size, sizeof(_sg_pass_t));
     SOKOL_ASSERT((desc->context_pool_size > 0) && (desc->context_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->context_pool, desc->context_pool_size);
-    size_t context_pool_byte_size = sizeof(_sg_context_t) * (size_t)p->context_pool.size;
-    p->contexts = (_sg_context_t*) SOKOL_MALLOC(context_pool_byte_size);
-    SOKOL_ASSERT(p->contexts);
-    memset(p->contexts, 0, context_pool_byte_size);
+    _sg_init_pool(&p->context_pool, desc->context_pool_size, sizeof(_sg_context_t));
 }
 
 _SOKOL_PRIVATE void _sg_discard_pools(_sg_pools_t* p) {
     SOKOL_ASSERT(p);
-    SOKOL_FREE(p->contexts);    p->contexts = 0;
-    SOKOL_FREE(p->passes);      p->passes = 0;
-    SOKOL_FREE(p->pipelines);   p->pipelines = 0;
-    SOKOL_FREE(p->shaders);     p->shaders = 0;
-    SOKOL_FREE(p->images);      p->images = 0;
-    SOKOL_FREE(p->buffers);     p->buffers = 0;
     _sg_discard_pool(&p->context_pool);
     _sg_discard_pool(&p->pass_pool);
     _sg_discard_pool(&p->pipeline_pool);
@@ -13389,42 +14334,42 @@ _SOKOL_PRIVATE _sg_buffer_t* _sg_buffer_at(const _sg_pools_t* p, uint32_t buf_id
     SOKOL_ASSERT(p && (SG_INVALID_ID != buf_id));
     int slot_index = _sg_slot_index(buf_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->buffer_pool.size));
-    return &p->buffers[slot_index];
+    return (_sg_buffer_t*) _sg_pool_item(&p->buffer_pool, slot_index);
 }
 
 _SOKOL_PRIVATE _sg_image_t* _sg_image_at(const _sg_pools_t* p, uint32_t img_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != img_id));
     int slot_index = _sg_slot_index(img_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->image_pool.size));
-    return &p->images[slot_index];
+    return (_sg_image_t*) _sg_pool_item(&p->image_pool, slot_index);
 }
 
 _SOKOL_PRIVATE _sg_shader_t* _sg_shader_at(const _sg_pools_t* p, uint32_t shd_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != shd_id));
     int slot_index = _sg_slot_index(shd_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->shader_pool.size));
-    return &p->shaders[slot_index];
+    return (_sg_shader_t*) _sg_pool_item(&p->shader_pool, slot_index);
 }
 
 _SOKOL_PRIVATE _sg_pipeline_t* _sg_pipeline_at(const _sg_pools_t* p, uint32_t pip_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != pip_id));
     int slot_index = _sg_slot_index(pip_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->pipeline_pool.size));
-    return &p->pipelines[slot_index];
+    return (_sg_pipeline_t*) _sg_pool_item(&p->pipeline_pool, slot_index);
 }
 
 _SOKOL_PRIVATE _sg_pass_t* _sg_pass_at(const _sg_pools_t* p, uint32_t pass_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != pass_id));
     int slot_index = _sg_slot_index(pass_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->pass_pool.size));
-    return &p->passes[slot_index];
+    return (_sg_pass_t*) _sg_pool_item(&p->pass_pool, slot_index);
 }
 
 _SOKOL_PRIVATE _sg_context_t* _sg_context_at(const _sg_pools_t* p, uint32_t context_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != context_id));
     int slot_index = _sg_slot_index(context_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->context_pool.size));
-    return &p->contexts[slot_index];
+    return (_sg_context_t*) _sg_pool_item(&p->context_pool, slot_index);
 }
 
 /* returns pointer to resource with matching id check, may return 0 */
@@ -13501,42 +14446,47 @@ _SOKOL_PRIVATE void _sg_destroy_all_resources(_sg_pools_t* p, uint32_t ctx_id) {
               and the resource slots not be cleared!
     */
     for (int i = 1; i < p->buffer_pool.size; i++) {
-        if (p->buffers[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->buffers[i].slot.state;
+        _sg_buffer_t* buf = (_sg_buffer_t*) _sg_pool_item(&p->buffer_pool, i);
+        if (buf->slot.ctx_id == ctx_id) {
+            sg_resource_state state = buf->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_buffer(&p->buffers[i]);
+                _sg_destroy_buffer(buf);
             }
         }
     }
     for (int i = 1; i < p->image_pool.size; i++) {
-        if (p->images[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->images[i].slot.state;
+        _sg_image_t* img = (_sg_image_t*) _sg_pool_item(&p->image_pool, i);
+        if (img->slot.ctx_id == ctx_id) {
+            sg_resource_state state = img->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_image(&p->images[i]);
+                _sg_destroy_image(img);
             }
         }
     }
     for (int i = 1; i < p->shader_pool.size; i++) {
-        if (p->shaders[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->shaders[i].slot.state;
+        _sg_shader_t* shd = (_sg_shader_t*) _sg_pool_item(&p->shader_pool, i);
+        if (shd->slot.ctx_id == ctx_id) {
+            sg_resource_state state = shd->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_shader(&p->shaders[i]);
+                _sg_destroy_shader(shd);
             }
         }
     }
     for (int i = 1; i < p->pipeline_pool.size; i++) {
-        if (p->pipelines[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->pipelines[i].slot.state;
+        _sg_pipeline_t* pip = (_sg_pipeline_t*) _sg_pool_item(&p->pipeline_pool, i);
+        if (pip->slot.ctx_id == ctx_id) {
+            sg_resource_state state = pip->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_pipeline(&p->pipelines[i]);
+                _sg_destroy_pipeline(pip);
             }
         }
     }
     for (int i = 1; i < p->pass_pool.size; i++) {
-        if (p->passes[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->passes[i].slot.state;
+        _sg_pass_t* pass = (_sg_pass_t*) _sg_pool_item(&p->pass_pool, i);
+        if (pass->slot.ctx_id == ctx_id) {
+            sg_resource_state state = pass->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_destroy_pass(&p->passes[i]);
+                _sg_destroy_pass(pass);
             }
         }
     }
@@ -14414,7 +15364,8 @@ _SOKOL_PRIVATE sg_buffer _sg_alloc_buffer(void) {
     sg_buffer res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.buffer_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.buffer_pool, &_sg.pools.buffers[slot_index].slot, slot_index);
+        _sg_buffer_t* buf = (_sg_buffer_t*) _sg_pool_item(&_sg.pools.buffer_pool, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.buffer_pool, &buf->slot, slot_index);
     }
     else {
         /* pool is exhausted */
@@ -14427,7 +15378,8 @@ _SOKOL_PRIVATE sg_image _sg_alloc_image(void) {
     sg_image res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.image_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.image_pool, &_sg.pools.images[slot_index].slot, slot_index);
+        _sg_image_t* img = (_sg_image_t*) _sg_pool_item(&_sg.pools.image_pool, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.image_pool, &img->slot, slot_index);
     }
     else {
         /* pool is exhausted */
@@ -14440,7 +15392,8 @@ _SOKOL_PRIVATE sg_shader _sg_alloc_shader(void) {
     sg_shader res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.shader_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.shader_pool, &_sg.pools.shaders[slot_index].slot, slot_index);
+        _sg_shader_t* shd = (_sg_shader_t*) _sg_pool_item(&_sg.pools.shader_pool, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.shader_pool, &shd->slot, slot_index);
     }
     else {
         /* pool is exhausted */
@@ -14453,7 +15406,8 @@ _SOKOL_PRIVATE sg_pipeline _sg_alloc_pipeline(void) {
     sg_pipeline res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.pipeline_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id =_sg_slot_alloc(&_sg.pools.pipeline_pool, &_sg.pools.pipelines[slot_index].slot, slot_index);
+        _sg_pipeline_t* pip = (_sg_pipeline_t*) _sg_pool_item(&_sg.pools.pipeline_pool, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.pipeline_pool, &pip->slot, slot_index);
     }
     else {
         /* pool is exhausted */
@@ -14466,7 +15420,8 @@ _SOKOL_PRIVATE sg_pass _sg_alloc_pass(void) {
     sg_pass res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.pass_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.pass_pool, &_sg.pools.passes[slot_index].slot, slot_index);
+        _sg_pass_t* pass = (_sg_pass_t*) _sg_pool_item(&_sg.pools.pass_pool, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.pass_pool, &pass->slot, slot_index);
     }
     else {
         /* pool is exhausted */
@@ -14733,9 +15688,11 @@ SOKOL_API_IMPL void sg_setup(const sg_desc* desc) {
     _sg.desc.uniform_buffer_size = _sg_def(_sg.desc.uniform_buffer_size, _SG_DEFAULT_UB_SIZE);
     _sg.desc.staging_buffer_size = _sg_def(_sg.desc.staging_buffer_size, _SG_DEFAULT_STAGING_SIZE);
     _sg.desc.sampler_cache_size = _sg_def(_sg.desc.sampler_cache_size, _SG_DEFAULT_SAMPLER_CACHE_CAPACITY);
+    _sg.desc.context.gl.vao_cache_size = _sg_def(_sg.desc.context.gl.vao_cache_size, _SG_DEFAULT_VAO_CACHE_SIZE);
 
     _sg_setup_pools(&_sg.pools, &_sg.desc);
     _sg.frame_index = 1;
+    _sg.stats.frame_index = _sg.frame_index;
     _sg_setup_backend(&_sg.desc);
     _sg.valid = true;
     sg_setup_context();
@@ -14794,8 +15751,8 @@ SOKOL_API_IMPL sg_context sg_setup_context(void) {
     sg_context res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.context_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.context_pool, &_sg.pools.contexts[slot_index].slot, slot_index);
-        _sg_context_t* ctx = _sg_context_at(&_sg.pools, res.id);
+        _sg_context_t* ctx = (_sg_context_t*) _sg_pool_item(&_sg.pools.context_pool, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.context_pool, &ctx->slot, slot_index);
         ctx->slot.state = _sg_create_context(ctx);
         SOKOL_ASSERT(ctx->slot.state == SG_RESOURCESTATE_VALID);
         _sg_activate_context(ctx);
@@ -15196,6 +16153,7 @@ SOKOL_API_IMPL void sg_begin_default_pass(const sg_pass_action* pass_action, int
     _sg_resolve_default_pass_action(pass_action, &pa);
     _sg.cur_pass.id = SG_INVALID_ID;
     _sg.pass_valid = true;
+    _sg.stats.num_passes++;
     _sg_begin_pass(0, &pa, width, height);
     _SG_TRACE_ARGS(begin_default_pass, pass_action, width, height);
 }
@@ -15218,6 +16176,7 @@ SOKOL_API_IMPL void sg_begin_pass(sg_pass pass_id, const sg_pass_action* pass_ac
         SOKOL_ASSERT(img);
         const int w = img->cmn.width;
         const int h = img->cmn.height;
+        _sg.stats.num_passes++;
         _sg_begin_pass(pass, &pa, w, h);
         _SG_TRACE_ARGS(begin_pass, pass_id, pass_action);
     }
@@ -15272,6 +16231,7 @@ SOKOL_API_IMPL void sg_apply_pipeline(sg_pipeline pip_id) {
     SOKOL_ASSERT(pip);
     _sg.next_draw_valid = (SG_RESOURCESTATE_VALID == pip->slot.state);
     SOKOL_ASSERT(pip->shader && (pip->shader->slot.id == pip->cmn.shader_id.id));
+    _sg.stats.num_apply_pipeline++;
     _sg_apply_pipeline(pip);
     _SG_TRACE_ARGS(apply_pipeline, pip_id);
 }
@@ -15340,6 +16300,7 @@ SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
     if (_sg.next_draw_valid) {
         const int* vb_offsets = bindings->vertex_buffer_offsets;
         int ib_offset = bindings->index_buffer_offset;
+        _sg.stats.num_apply_bindings++;
         _sg_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
         _SG_TRACE_ARGS(apply_bindings, bindings);
     }
@@ -15365,6 +16326,8 @@ SOKOL_API_IMPL void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const
     if (!_sg.next_draw_valid) {
         _SG_TRACE_NOARGS(err_draw_invalid);
     }
+    _sg.stats.num_apply_uniforms++;
+    _sg.stats.size_apply_uniforms += (uint32_t)data->size;
     _sg_apply_uniforms(stage, ub_index, data);
     _SG_TRACE_ARGS(apply_uniforms, stage, ub_index, data);
 }
@@ -15398,7 +16361,12 @@ SOKOL_API_IMPL void sg_draw(int base_element, int num_elements, int num_instance
         _SG_TRACE_NOARGS(err_draw_invalid);
         return;
     }
+    _sg.stats.num_draw++;
+    _sg.stats.num_instances += (uint32_t)num_instances;
+    _sg.stats.num_vertices += (uint32_t)num_elements * (uint32_t)num_instances;
+    SOKOL_PROF_BEGIN("sg_draw");
     _sg_draw(base_element, num_elements, num_instances);
+    SOKOL_PROF_END();
     _SG_TRACE_ARGS(draw, base_element, num_elements, num_instances);
 }
 
@@ -15417,9 +16385,14 @@ SOKOL_API_IMPL void sg_end_pass(void) {
 
 SOKOL_API_IMPL void sg_commit(void) {
     SOKOL_ASSERT(_sg.valid);
+    SOKOL_PROF_BEGIN("sg_commit");
     _sg_commit();
+    SOKOL_PROF_END();
     _SG_TRACE_NOARGS(commit);
+    _sg.prev_stats = _sg.stats;
     _sg.frame_index++;
+    memset(&_sg.stats, 0, sizeof(_sg.stats));
+    _sg.stats.frame_index = _sg.frame_index;
 }
 
 SOKOL_API_IMPL void sg_reset_state_cache(void) {
@@ -15439,6 +16412,8 @@ SOKOL_API_IMPL void sg_update_buffer(sg_buffer buf_id, const sg_range* data) {
             SOKOL_ASSERT(buf->cmn.update_frame_index != _sg.frame_index);
             /* update and append on same buffer in same frame not allowed */
             SOKOL_ASSERT(buf->cmn.append_frame_index != _sg.frame_index);
+            _sg.stats.num_update_buffer++;
+            _sg.stats.size_update_buffer += (uint32_t)data->size;
             _sg_update_buffer(buf, data);
             buf->cmn.update_frame_index = _sg.frame_index;
         }
@@ -15466,7 +16441,11 @@ SOKOL_API_IMPL int sg_append_buffer(sg_buffer buf_id, const sg_range* data) {
                 if (!buf->cmn.append_overflow && (data->size > 0)) {
                     /* update and append on same buffer in same frame not allowed */
                     SOKOL_ASSERT(buf->cmn.update_frame_index != _sg.frame_index);
+                    SOKOL_PROF_BEGIN("sg_append_buffer");
                     int copied_num_bytes = _sg_append_buffer(buf, data, buf->cmn.append_frame_index != _sg.frame_index);
+                    SOKOL_PROF_END();
+                    _sg.stats.num_append_buffer++;
+                    _sg.stats.size_append_buffer += (uint32_t)copied_num_bytes;
                     buf->cmn.append_pos += copied_num_bytes;
                     buf->cmn.append_frame_index = _sg.frame_index;
                 }
@@ -15495,6 +16474,12 @@ SOKOL_API_IMPL void sg_update_image(sg_image img_id, const sg_image_data* data)
     if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
         if (_sg_validate_update_image(img, data)) {
             SOKOL_ASSERT(img->cmn.upd_frame_index != _sg.frame_index);
+            _sg.stats.num_update_image++;
+            for (int face_index = 0; face_index < SG_CUBEFACE_NUM; face_index++) {
+                for (int mip_index = 0; mip_index < img->cmn.num_mipmaps; mip_index++) {
+                    _sg.stats.size_update_image += (uint32_t)data->subimage[face_index][mip_index].size;
+                }
+            }
             _sg_update_image(img, data);
             img->cmn.upd_frame_index = _sg.frame_index;
         }
@@ -15599,6 +16584,33 @@ SOKOL_API_IMPL sg_pass_info sg_query_pass_info(sg_pass pass_id) {
     return info;
 }
 
+_SOKOL_PRIVATE sg_pool_info _sg_pool_info(const _sg_pool_t* pool) {
+    sg_pool_info info;
+    memset(&info, 0, sizeof(info));
+    /* slot 0 is reserved */
+    info.capacity = pool->size - 1;
+    info.num_used = info.capacity - pool->queue_top;
+    info.grow_count = pool->grow_count;
+    return info;
+}
+
+SOKOL_API_IMPL sg_pool_stats sg_query_pool_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_pool_stats stats;
+    stats.buffers = _sg_pool_info(&_sg.pools.buffer_pool);
+    stats.images = _sg_pool_info(&_sg.pools.image_pool);
+    stats.shaders = _sg_pool_info(&_sg.pools.shader_pool);
+    stats.pipelines = _sg_pool_info(&_sg.pools.pipeline_pool);
+    stats.passes = _sg_pool_info(&_sg.pools.pass_pool);
+    stats.contexts = _sg_pool_info(&_sg.pools.context_pool);
+    return stats;
+}
+
+SOKOL_API_IMPL sg_frame_stats sg_query_frame_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.prev_stats;
+}
+
 SOKOL_API_IMPL sg_buffer_desc sg_query_buffer_defaults(const sg_buffer_desc* desc) {
     SOKOL_ASSERT(_sg.valid && desc);
     return _sg_buffer_desc_defaults(desc);
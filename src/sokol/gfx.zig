@@ -599,8 +599,56 @@ pub const PipelineInfo = extern struct {
 pub const PassInfo = extern struct {
     slot: SlotInfo = .{ },
 };
+pub const PoolInfo = extern struct {
+    capacity: i32 = 0,
+    num_used: i32 = 0,
+    grow_count: i32 = 0,
+};
+pub const PoolStats = extern struct {
+    buffers: PoolInfo = .{ },
+    images: PoolInfo = .{ },
+    shaders: PoolInfo = .{ },
+    pipelines: PoolInfo = .{ },
+    passes: PoolInfo = .{ },
+    contexts: PoolInfo = .{ },
+};
+pub const FrameStatsGl = extern struct {
+    num_use_program: u32 = 0,
+    num_bind_buffer: u32 = 0,
+    num_bind_texture: u32 = 0,
+    num_vertex_attrib_pointer: u32 = 0,
+    num_enable_vertex_attrib_array: u32 = 0,
+    num_disable_vertex_attrib_array: u32 = 0,
+    num_uniform: u32 = 0,
+    num_bind_uniform_buffer: u32 = 0,
+    num_bind_vertex_array: u32 = 0,
+    num_vertex_array_cache_miss: u32 = 0,
+    num_redundant_pipeline: u32 = 0,
+    num_redundant_bind_buffer: u32 = 0,
+    num_redundant_bind_texture: u32 = 0,
+    num_redundant_vertex_attrib: u32 = 0,
+};
+pub const FrameStats = extern struct {
+    frame_index: u32 = 0,
+    num_passes: u32 = 0,
+    num_apply_pipeline: u32 = 0,
+    num_apply_bindings: u32 = 0,
+    num_apply_uniforms: u32 = 0,
+    num_draw: u32 = 0,
+    num_instances: u32 = 0,
+    num_vertices: u32 = 0,
+    num_update_buffer: u32 = 0,
+    num_append_buffer: u32 = 0,
+    num_update_image: u32 = 0,
+    size_apply_uniforms: u32 = 0,
+    size_update_buffer: u32 = 0,
+    size_append_buffer: u32 = 0,
+    size_update_image: u32 = 0,
+    gl: FrameStatsGl = .{ },
+};
 pub const GlContextDesc = extern struct {
     force_gles2: bool = false,
+    vao_cache_size: i32 = 0,
 };
 pub const MetalContextDesc = extern struct {
     device: ?*const c_void = null,
@@ -844,6 +892,14 @@ pub extern fn sg_query_pass_info(Pass) PassInfo;
 pub fn queryPassInfo(pass: Pass) PassInfo {
     return sg_query_pass_info(pass);
 }
+pub extern fn sg_query_pool_stats() PoolStats;
+pub fn queryPoolStats() PoolStats {
+    return sg_query_pool_stats();
+}
+pub extern fn sg_query_frame_stats() FrameStats;
+pub fn queryFrameStats() FrameStats {
+    return sg_query_frame_stats();
+}
 pub extern fn sg_query_buffer_defaults([*c]const BufferDesc) BufferDesc;
 pub fn queryBufferDefaults(desc: BufferDesc) BufferDesc {
     return sg_query_buffer_defaults(&desc);
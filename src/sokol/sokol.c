@@ -1,4 +1,6 @@
 #define SOKOL_IMPL
 #include "c/sokol_defines.h"
 #include "c/sokol_app.h"
-#include "c/sokol_gfx.h"
\ No newline at end of file
+#include "c/sokol_gfx.h"
+#include "c/sokol_time.h"
+#include "c/sokol_debugtext.h"
@@ -0,0 +1,8 @@
+// sokol without a window or a GPU, used by the benchmarks ('zig build bench')
+#define SOKOL_IMPL
+#define SOKOL_DUMMY_BACKEND
+#include "c/sokol_defines.h"
+#include "c/sokol_gfx.h"
+#include "c/sokol_time.h"
+#include "c/sokol_gl.h"
+#include "c/sokol_debugtext.h"
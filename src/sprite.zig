@@ -0,0 +1,68 @@
+//------------------------------------------------------------------------------
+//  sprite.zig
+//
+//  sprite render commands and their packing into GPU instances
+//
+//  a sprite is one 32 byte instance, sprite.glsl expands the shared unit
+//  quad: scale, rotate, translate, then samples the atlas rect
+//------------------------------------------------------------------------------
+const std = @import("std");
+const math = @import("math.zig");
+const assets = @import("assets.zig");
+const atlas = @import("atlas"); // generated by tools/bake_assets.zig
+const vec2 = math.Vec2;
+const ImageID = assets.ImageID;
+
+pub const RenderCommandSprite = struct {
+    pos: vec2,
+    scale: vec2 = vec2.new(1, 1),
+    rot: f32 = 0,
+    color: u32 = 0xFFFFFFFF,
+    imgID: ImageID,
+};
+
+// per instance vertex data, must match the inst_* attributes of sprite.glsl
+pub const SpriteInstance = extern struct {
+    pos: [2]f32,
+    scale: [2]f32,
+    rot: f32,
+    color: u32, // 0xAABBGGRR, read as UBYTE4N
+    uv: [4]u16, // atlas rect u0, v0, u1, v1, read as USHORT4N
+};
+
+comptime {
+    std.debug.assert(@sizeOf(SpriteInstance) == 32);
+}
+
+// atlas rects in the instance format, converted once at compile time
+const packed_uv_rects = blk: {
+    var rects: [atlas.uv_rects.len][4]u16 = undefined;
+    for (atlas.uv_rects) |rect, i| {
+        for (rect) |v, c| {
+            rects[i][c] = @floatToInt(u16, v * 65535.0 + 0.5);
+        }
+    }
+    break :blk rects;
+};
+
+// atlas rect of an image
+pub fn atlasRect(imgID: ImageID) [4]u16 {
+    return packed_uv_rects[imgID.u];
+}
+
+pub fn instance(cmd: RenderCommandSprite) SpriteInstance {
+    return .{
+        .pos = .{ cmd.pos.x, cmd.pos.y },
+        .scale = .{ cmd.scale.x, cmd.scale.y },
+        .rot = cmd.rot,
+        .color = cmd.color,
+        .uv = atlasRect(cmd.imgID),
+    };
+}
+
+// out must be as long as queue
+pub fn packInstances(queue: []const RenderCommandSprite, out: []SpriteInstance) void {
+    for (queue) |cmd, i| {
+        out[i] = instance(cmd);
+    }
+}
@@ -0,0 +1,42 @@
+//------------------------------------------------------------------------------
+//  testfiles.zig
+//
+//  scratch files for the tests of modules which open files by path
+//------------------------------------------------------------------------------
+const std = @import("std");
+
+// a named file in its own std.testing.tmpDir, path is absolute so opening it
+// doesn't depend on the working directory or on where tmpDir puts things
+pub const TmpFile = struct {
+    tmp: std.testing.TmpDir,
+    name: []const u8,
+    path: []u8,
+
+    pub fn init(name: []const u8) !TmpFile {
+        var tmp = std.testing.tmpDir(.{});
+        errdefer tmp.cleanup();
+        const dir = try tmp.dir.realpathAlloc(std.testing.allocator, ".");
+        defer std.testing.allocator.free(dir);
+        const path = try std.fs.path.join(std.testing.allocator, &[_][]const u8{ dir, name });
+        return TmpFile{ .tmp = tmp, .name = name, .path = path };
+    }
+
+    pub fn deinit(self: *TmpFile) void {
+        std.testing.allocator.free(self.path);
+        self.tmp.cleanup();
+    }
+
+    pub fn write(self: TmpFile, bytes: []const u8) !void {
+        try self.tmp.dir.writeFile(self.name, bytes);
+    }
+};
+
+// T.open(allocator, path) must fail with expected, anything it opens is closed
+pub fn expectOpenError(comptime T: type, expected: anyerror, path: []const u8) !void {
+    var opened = T.open(std.testing.allocator, path) catch |err| {
+        std.debug.assert(err == expected);
+        return;
+    };
+    opened.close();
+    return error.TestUnexpectedResult;
+}
@@ -0,0 +1,239 @@
+//------------------------------------------------------------------------------
+//  bake_assets.zig
+//
+//  packs every image of g_ImageList into one RGBA8 atlas and bakes it, with
+//  atlas_mips mip levels, into the asset pack described in src/pack.zig
+//
+//  usage: bake_assets <assets.pack> <atlas.zig>
+//
+//  atlas.zig is a generated table with the atlas size and the UV rect of each
+//  ImageID, imported by the game as the "atlas" package so rect lookups
+//  resolve at comptime
+//------------------------------------------------------------------------------
+const std = @import("std");
+const assets = @import("assets");
+const pack = @import("pack");
+const png = @import("png.zig");
+
+// the chain stops at atlas_mips levels: every image starts on a cell
+// boundary, is padded to whole cells and gets a ring of extruded edge texels
+// one cell wide, so down to the last level a texel never mixes two images
+// and filtering never bleeds into a neighbour
+const atlas_mips = 5;
+const cell = 1 << (atlas_mips - 1);
+const border = cell;
+
+comptime {
+    std.debug.assert(atlas_mips <= pack.max_mips);
+}
+// size of the white block behind ImageID 0, used by untextured sprites
+const white_size = 4;
+
+const Rect = struct {
+    x: u32 = 0,
+    y: u32 = 0,
+    w: u32,
+    h: u32,
+};
+
+fn higherFirst(rects: []const Rect, a: usize, b: usize) bool {
+    return rects[a].h > rects[b].h;
+}
+
+fn padToCell(v: u32) u32 {
+    return std.mem.alignForwardGeneric(u32, v, cell);
+}
+
+fn nextPow2(v: u32) u32 {
+    var p: u32 = 1;
+    while (p < v) p *= 2;
+    return p;
+}
+
+// simple shelf packer, rects are placed highest first, returns the used height
+fn shelfPack(rects: []Rect, order: []const usize, width: u32) ?u32 {
+    var x: u32 = 0;
+    var y: u32 = 0;
+    var shelf_h: u32 = 0;
+    for (order) |i| {
+        const w = padToCell(rects[i].w) + border * 2;
+        const h = padToCell(rects[i].h) + border * 2;
+        if (w > width) return null;
+        if (x + w > width) {
+            x = 0;
+            y += shelf_h;
+            shelf_h = 0;
+        }
+        rects[i].x = x + border;
+        rects[i].y = y + border;
+        x += w;
+        shelf_h = std.math.max(shelf_h, h);
+    }
+    return y + shelf_h;
+}
+
+fn blit(atlas: []u8, atlas_w: u32, rect: Rect, pixels: []const u8) void {
+    // the padding and the border ring repeat the closest edge texel
+    var y: i64 = -border;
+    while (y < padToCell(rect.h) + border): (y += 1) {
+        const sy = @intCast(u32, std.math.clamp(y, 0, @as(i64, rect.h) - 1));
+        var x: i64 = -border;
+        while (x < padToCell(rect.w) + border): (x += 1) {
+            const sx = @intCast(u32, std.math.clamp(x, 0, @as(i64, rect.w) - 1));
+            const dx = @intCast(u32, @intCast(i64, rect.x) + x);
+            const dy = @intCast(u32, @intCast(i64, rect.y) + y);
+            const src = pixels[(sy * rect.w + sx) * 4 ..][0..4];
+            std.mem.copy(u8, atlas[(dy * atlas_w + dx) * 4 ..][0..4], src);
+        }
+    }
+}
+
+// 2x2 box filter, odd sizes clamp the last row/column
+fn downsample(dst: []u8, src: []const u8, src_w: u32, src_h: u32) void {
+    const dst_w = std.math.max(src_w / 2, 1);
+    const dst_h = std.math.max(src_h / 2, 1);
+    var y: u32 = 0;
+    while (y < dst_h): (y += 1) {
+        const y0 = std.math.min(y * 2, src_h - 1);
+        const y1 = std.math.min(y * 2 + 1, src_h - 1);
+        var x: u32 = 0;
+        while (x < dst_w): (x += 1) {
+            const x0 = std.math.min(x * 2, src_w - 1);
+            const x1 = std.math.min(x * 2 + 1, src_w - 1);
+            var c: usize = 0;
+            while (c < 4): (c += 1) {
+                const sum = @as(u32, src[(y0 * src_w + x0) * 4 + c]) +
+                            src[(y0 * src_w + x1) * 4 + c] +
+                            src[(y1 * src_w + x0) * 4 + c] +
+                            src[(y1 * src_w + x1) * 4 + c];
+                dst[(y * dst_w + x) * 4 + c] = @intCast(u8, (sum + 2) / 4);
+            }
+        }
+    }
+}
+
+fn alignForward(offset: u64) u64 {
+    return std.mem.alignForwardGeneric(u64, offset, pack.data_align);
+}
+
+// writes the atlas and its first atlas_mips levels as the only image of the pack
+fn writePack(allocator: *std.mem.Allocator, path: []const u8, pixels: []const u8, width: u32, height: u32) !void {
+    var levels = std.ArrayList([]const u8).init(allocator);
+    defer {
+        for (levels.items[1..]) |level| allocator.free(level);
+        levels.deinit();
+    }
+    try levels.append(pixels);
+
+    var rec = pack.ImageRecord { .width = width, .height = height, .mip_count = 1 };
+    var w = width;
+    var h = height;
+    while ((w > 1 or h > 1) and levels.items.len < atlas_mips) {
+        const next_w = std.math.max(w / 2, 1);
+        const next_h = std.math.max(h / 2, 1);
+        const level = try allocator.alloc(u8, next_w * next_h * 4);
+        downsample(level, levels.items[levels.items.len - 1], w, h);
+        try levels.append(level);
+        w = next_w;
+        h = next_h;
+    }
+    rec.mip_count = @intCast(u32, levels.items.len);
+
+    const hdr = pack.Header { .image_count = 1 };
+    var offset = alignForward(@sizeOf(pack.Header) + @sizeOf(pack.ImageRecord));
+    for (levels.items) |level, i| {
+        rec.mips[i] = .{ .offset = offset, .size = level.len };
+        offset = alignForward(offset + level.len);
+    }
+
+    const file = try std.fs.cwd().createFile(path, .{});
+    defer file.close();
+    var buffered = std.io.bufferedWriter(file.writer());
+    var counting = std.io.countingWriter(buffered.writer());
+    const out = counting.writer();
+    try out.writeAll(std.mem.asBytes(&hdr));
+    try out.writeAll(std.mem.asBytes(&rec));
+    for (levels.items) |level, i| {
+        try out.writeByteNTimes(0, @intCast(usize, rec.mips[i].offset - counting.bytes_written));
+        try out.writeAll(level);
+    }
+    try buffered.flush();
+}
+
+pub fn main() !void {
+    var gpa = std.heap.GeneralPurposeAllocator(.{}){};
+    defer _ = gpa.deinit();
+    const allocator = &gpa.allocator;
+
+    const args = try std.process.argsAlloc(allocator);
+    defer std.process.argsFree(allocator, args);
+    if (args.len != 3) {
+        std.log.err("usage: {s} <assets.pack> <atlas.zig>", .{args[0]});
+        return error.InvalidArgs;
+    }
+
+    // slot 0 is the white block, slot i+1 is g_ImageList[i]
+    const count = assets.g_ImageList.len + 1;
+    var images: [count]png.Image = undefined;
+    var rects: [count]Rect = undefined;
+
+    var white = [_]u8{0xFF} ** (white_size * white_size * 4);
+    images[0] = .{ .width = white_size, .height = white_size, .pixels = &white };
+    rects[0] = .{ .w = white_size, .h = white_size };
+
+    for (assets.g_ImageList) |entry, i| {
+        const bytes = try std.fs.cwd().readFileAlloc(allocator, entry.path, 64 * 1024 * 1024);
+        defer allocator.free(bytes);
+        images[i + 1] = png.decode(allocator, bytes) catch |err| {
+            std.log.err("{s}: {s}", .{ entry.path, @errorName(err) });
+            return err;
+        };
+        rects[i + 1] = .{ .w = images[i + 1].width, .h = images[i + 1].height };
+    }
+    defer for (images[1..]) |*img| img.deinit(allocator);
+
+    var order: [count]usize = undefined;
+    for (order) |*o, i| o.* = i;
+    std.sort.sort(usize, &order, @as([]const Rect, &rects), higherFirst);
+
+    // grow the width until everything fits in a square-ish power of two
+    var width: u32 = 256;
+    var height: u32 = undefined;
+    while (true): (width *= 2) {
+        if (shelfPack(&rects, &order, width)) |used| {
+            if (used <= width) {
+                height = nextPow2(used);
+                break;
+            }
+        }
+    }
+
+    var pixels = try allocator.alloc(u8, width * height * 4);
+    defer allocator.free(pixels);
+    std.mem.set(u8, pixels, 0);
+    for (rects) |rect, i| {
+        blit(pixels, width, rect, images[i].pixels);
+    }
+
+    try writePack(allocator, args[1], pixels, width, height);
+
+    var source = std.ArrayList(u8).init(allocator);
+    defer source.deinit();
+    const out = source.writer();
+    try out.print("// machine generated by tools/bake_assets.zig, do not edit\n\n", .{});
+    try out.print("pub const width = {d};\n", .{width});
+    try out.print("pub const height = {d};\n\n", .{height});
+    try out.print("// u0, v0, u1, v1 per ImageID\n", .{});
+    try out.print("pub const uv_rects = [_][4]f32 {{\n", .{});
+    for (rects) |rect, i| {
+        const u0 = @intToFloat(f32, rect.x) / @intToFloat(f32, width);
+        const v0 = @intToFloat(f32, rect.y) / @intToFloat(f32, height);
+        const u_1 = @intToFloat(f32, rect.x + rect.w) / @intToFloat(f32, width);
+        const v_1 = @intToFloat(f32, rect.y + rect.h) / @intToFloat(f32, height);
+        const name = if (i == 0) "white" else assets.g_ImageList[i - 1].path;
+        try out.print("    .{{ {d}, {d}, {d}, {d} }}, // {s}\n", .{ u0, v0, u_1, v_1, name });
+    }
+    try out.print("}};\n", .{});
+
+    try std.fs.cwd().writeFile(args[2], source.items);
+}
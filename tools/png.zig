@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+//  png.zig
+//
+//  minimal PNG decoder for the asset bake tools: 8 bit, non-interlaced
+//  grey, grey+alpha, RGB, RGBA and palette images, always decoded to RGBA8
+//------------------------------------------------------------------------------
+const std = @import("std");
+const mem = std.mem;
+
+pub const Image = struct {
+    width: u32,
+    height: u32,
+    pixels: []u8, // RGBA8, rows top to bottom
+
+    pub fn deinit(self: *Image, allocator: *mem.Allocator) void {
+        allocator.free(self.pixels);
+    }
+};
+
+pub const Error = error {
+    InvalidSignature,
+    InvalidHeader,
+    UnsupportedFormat,
+    InvalidFilter,
+    TruncatedData,
+};
+
+const signature = [_]u8 { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+fn channelCount(color_type: u8) Error!usize {
+    return switch (color_type) {
+        0 => 1, // grey
+        2 => 3, // RGB
+        3 => 1, // palette
+        4 => 2, // grey + alpha
+        6 => 4, // RGBA
+        else => error.UnsupportedFormat,
+    };
+}
+
+fn paeth(a: u8, b: u8, c: u8) u8 {
+    const p = @as(i16, a) + @as(i16, b) - @as(i16, c);
+    const pa = std.math.absInt(p - a) catch unreachable;
+    const pb = std.math.absInt(p - b) catch unreachable;
+    const pc = std.math.absInt(p - c) catch unreachable;
+    if (pa <= pb and pa <= pc) return a;
+    if (pb <= pc) return b;
+    return c;
+}
+
+// undo the per scanline filters in place, raw holds (1 + stride) bytes per row
+fn unfilter(raw: []u8, height: usize, stride: usize, bpp: usize) Error!void {
+    var y: usize = 0;
+    while (y < height): (y += 1) {
+        const row = raw[y * (stride + 1) ..][0 .. stride + 1];
+        const filter = row[0];
+        const cur = row[1..];
+        const prev: ?[]const u8 = if (y > 0) raw[(y - 1) * (stride + 1) + 1 ..][0..stride] else null;
+
+        var x: usize = 0;
+        while (x < stride): (x += 1) {
+            const a: u8 = if (x >= bpp) cur[x - bpp] else 0;
+            const b: u8 = if (prev) |p| p[x] else 0;
+            const c: u8 = if (prev != null and x >= bpp) prev.?[x - bpp] else 0;
+            cur[x] = switch (filter) {
+                0 => cur[x],
+                1 => cur[x] +% a,
+                2 => cur[x] +% b,
+                3 => cur[x] +% @intCast(u8, (@as(u16, a) + b) / 2),
+                4 => cur[x] +% paeth(a, b, c),
+                else => return error.InvalidFilter,
+            };
+        }
+    }
+}
+
+pub fn decode(allocator: *mem.Allocator, bytes: []const u8) !Image {
+    if (bytes.len < signature.len or !mem.eql(u8, bytes[0..signature.len], &signature)) {
+        return error.InvalidSignature;
+    }
+
+    var width: u32 = 0;
+    var height: u32 = 0;
+    var color_type: u8 = 0;
+    var palette: [256][4]u8 = undefined;
+    for (palette) |*entry| {
+        entry.* = .{ 0, 0, 0, 255 };
+    }
+
+    var idat = std.ArrayList(u8).init(allocator);
+    defer idat.deinit();
+
+    var pos: usize = signature.len;
+    while (pos + 12 <= bytes.len) {
+        const len = mem.readIntBig(u32, bytes[pos..][0..4]);
+        const kind = bytes[pos + 4 ..][0..4];
+        if (pos + 12 + len > bytes.len) return error.TruncatedData;
+        const data = bytes[pos + 8 ..][0..len];
+        pos += 12 + len;
+
+        if (mem.eql(u8, kind, "IHDR")) {
+            if (len != 13) return error.InvalidHeader;
+            width = mem.readIntBig(u32, data[0..4]);
+            height = mem.readIntBig(u32, data[4..8]);
+            color_type = data[9];
+            // bit depth 8, deflate, adaptive filtering, no interlace
+            if (data[8] != 8 or data[10] != 0 or data[11] != 0 or data[12] != 0) {
+                return error.UnsupportedFormat;
+            }
+        }
+        else if (mem.eql(u8, kind, "PLTE")) {
+            var i: usize = 0;
+            while (i < len / 3 and i < 256): (i += 1) {
+                palette[i] = .{ data[i * 3], data[i * 3 + 1], data[i * 3 + 2], 255 };
+            }
+        }
+        else if (mem.eql(u8, kind, "tRNS") and color_type == 3) {
+            for (data) |alpha, i| {
+                if (i < 256) palette[i][3] = alpha;
+            }
+        }
+        else if (mem.eql(u8, kind, "IDAT")) {
+            try idat.appendSlice(data);
+        }
+        else if (mem.eql(u8, kind, "IEND")) {
+            break;
+        }
+    }
+
+    if (width == 0 or height == 0) return error.InvalidHeader;
+    const channels = try channelCount(color_type);
+    const stride = width * channels;
+
+    var raw = try allocator.alloc(u8, height * (stride + 1));
+    defer allocator.free(raw);
+
+    var stream = std.io.fixedBufferStream(idat.items);
+    var zlib = try std.compress.zlib.zlibStream(allocator, stream.reader());
+    defer zlib.deinit();
+    const read = try zlib.reader().readAll(raw);
+    if (read != raw.len) return error.TruncatedData;
+
+    try unfilter(raw, height, stride, channels);
+
+    var pixels = try allocator.alloc(u8, width * height * 4);
+    errdefer allocator.free(pixels);
+
+    var y: usize = 0;
+    while (y < height): (y += 1) {
+        const src = raw[y * (stride + 1) + 1 ..][0..stride];
+        const dst = pixels[y * width * 4 ..][0 .. width * 4];
+        var x: usize = 0;
+        while (x < width): (x += 1) {
+            const s = src[x * channels ..][0..channels];
+            const d = dst[x * 4 ..][0..4];
+            switch (color_type) {
+                0 => d.* = .{ s[0], s[0], s[0], 255 },
+                2 => d.* = .{ s[0], s[1], s[2], 255 },
+                3 => d.* = palette[s[0]],
+                4 => d.* = .{ s[0], s[0], s[0], s[1] },
+                6 => d.* = .{ s[0], s[1], s[2], s[3] },
+                else => unreachable,
+            }
+        }
+    }
+
+    return Image {
+        .width = width,
+        .height = height,
+        .pixels = pixels,
+    };
+}